@@ -10,7 +10,11 @@ from pathlib import Path
 from collections import defaultdict
 
 def cargar_resultados():
-    """Carga todos los resultados de las ejecuciones"""
+    """Carga todos los resultados de las ejecuciones
+    
+    Los CSV de barrido (./PSP-UAV --barrido) traen la instancia y la
+    configuración en cada fila; los de ejecuciones sueltas, en el nombre.
+    """
     resultados = []
     
     for archivo in sorted(Path("resultados").glob("*_estadisticas.csv")):
@@ -20,7 +24,8 @@ def cargar_resultados():
             reader = csv.DictReader(f)
             for row in reader:
                 resultados.append({
-                    'instancia': instancia,
+                    'instancia': row.get('instancia', instancia),
+                    'config': row.get('config', ''),
                     'num_drones': int(row['num_drones']),
                     'iteraciones': int(row['iteraciones']),
                     'ticks': int(row['ticks_operacion']),
@@ -59,6 +64,30 @@ def analizar_por_configuracion(resultados):
         tiempos = [r['tiempo'] for r in datos]
         print(f"   ⏱️  Tiempo promedio: {sum(tiempos)/len(tiempos):.2f}s")
 
+def analizar_por_parametros(resultados):
+    """Resume los barridos agrupando por configuración de parámetros y k"""
+    por_config = defaultdict(list)
+    
+    for r in resultados:
+        if r['config']:
+            por_config[(r['config'], r['num_drones'])].append(r)
+    
+    if not por_config:
+        return
+    
+    print("\n" + "=" * 80)
+    print("ANÁLISIS POR CONFIGURACIÓN DE PARÁMETROS (BARRIDO)")
+    print("=" * 80)
+    print(f"{'Config':<14} {'k':<5} {'Éxito':<8} {'Fitness prom.':<15} {'Tiempo prom. (s)':<16}")
+    
+    for (config, k) in sorted(por_config.keys()):
+        datos = por_config[(config, k)]
+        validos = [r['fitness'] for r in datos if r['valido']]
+        fitness_str = f"{sum(validos)/len(validos):,.0f}" if validos else "N/A"
+        tiempo = sum(r['tiempo'] for r in datos) / len(datos)
+        exito = f"{len(validos)}/{len(datos)}"
+        print(f"{config:<14} {k:<5} {exito:<8} {fitness_str:<15} {tiempo:<16.2f}")
+
 def generar_tabla_latex(resultados):
     """Genera tabla LaTeX con los resultados"""
     print("\n" + "=" * 80)
@@ -153,6 +182,7 @@ def main():
     
     # Análisis por configuración
     analizar_por_configuracion(resultados)
+    analizar_por_parametros(resultados)
     
     # Tabla LaTeX
     generar_tabla_latex(resultados)
@@ -10,16 +10,160 @@
 #include <iomanip>
 #include <algorithm>
 #include <sstream>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <memory>
+#include <array>
+#include <limits>
+#include <stdexcept>
+#include <charconv>
+#include <iterator>
+#include <numeric>
 #include <sys/stat.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PSP_X86 1
+#endif
 
 using namespace std;
 
 // Constante de penalización para individuos inválidos
 const double FITNESS_INVALIDO = 1e18;
 
-// Generador de números aleatorios Mersenne Twister
-random_device rd;
-mt19937 rng(rd());
+// Bits de la máscara de celdas de la representación densa
+const uint8_t CELDA_OBSTACULO = 1;
+const uint8_t CELDA_BASE = 2;
+
+// Desplazamiento (fila, columna) de cada acción 0-8 (mismo orden que aplicarAccion)
+const int DELTA_FILA[9] = {0, -1, -1, 0, 1, 1, 1, 0, -1};
+const int DELTA_COL[9]  = {0, 0, 1, 1, 1, 0, -1, -1, -1};
+
+/*
+ * Xoshiro256
+ * Generador xoshiro256** (Blackman y Vigna): 256 bits de estado, mucho más
+ * liviano que Mersenne Twister. El estado se inicializa con splitmix64.
+ */
+struct Xoshiro256 {
+    uint64_t s[4];
+
+    explicit Xoshiro256(uint64_t semilla = 0) {
+        for (uint64_t& palabra : s) {
+            semilla += 0x9e3779b97f4a7c15ULL;
+            uint64_t z = semilla;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            palabra = z ^ (z >> 31);
+        }
+    }
+
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    uint64_t operator()() {
+        uint64_t resultado = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return resultado;
+    }
+};
+
+// Algoritmo de generación de números aleatorios
+enum TipoRng {
+    RNG_MT19937,
+    RNG_XOSHIRO
+};
+
+// Tipo usado por defecto al crear generadores (se puede cambiar con --rng)
+TipoRng tipo_rng_defecto = RNG_MT19937;
+
+/*
+ * GeneradorRng
+ * Generador de números aleatorios de 64 bits usado por cada hilo del algoritmo
+ * evolutivo. Envuelve Mersenne Twister (mt19937_64) o xoshiro256** con la
+ * misma interfaz de UniformRandomBitGenerator, de modo que las distribuciones
+ * de <random> funcionan con ambos. Cada flujo se siembra con (semilla, flujo).
+ */
+class GeneradorRng {
+public:
+    using result_type = uint64_t;
+
+    explicit GeneradorRng(uint32_t semilla = 0, uint32_t flujo = 0, TipoRng t = tipo_rng_defecto)
+        : tipo(t), xoshiro((static_cast<uint64_t>(semilla) << 32) | flujo) {
+        seed_seq secuencia{semilla, flujo};
+        mt.seed(secuencia);
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type(0); }
+
+    result_type operator()() {
+        return (tipo == RNG_XOSHIRO) ? xoshiro() : mt();
+    }
+
+    TipoRng tipoGenerador() const { return tipo; }
+
+    /*
+     * estado
+     * - Recibe: nada
+     * - Retorna: estado completo del generador en uso (xoshiro: sus 4 palabras;
+     *   Mersenne Twister: su representación de texto estándar)
+     */
+    string estado() const {
+        if (tipo == RNG_XOSHIRO) {
+            return string(reinterpret_cast<const char*>(xoshiro.s), sizeof(xoshiro.s));
+        }
+        ostringstream ss;
+        ss << mt;
+        return ss.str();
+    }
+
+    /*
+     * restaurarEstado
+     * - Recibe: estado obtenido con estado() de un generador del mismo tipo
+     * - Retorna: void (lanza runtime_error si el estado no es válido)
+     */
+    void restaurarEstado(const string& e) {
+        if (tipo == RNG_XOSHIRO) {
+            if (e.size() != sizeof(xoshiro.s)) throw runtime_error("estado de xoshiro256** inválido");
+            memcpy(xoshiro.s, e.data(), sizeof(xoshiro.s));
+            return;
+        }
+        istringstream ss(e);
+        ss >> mt;
+        if (ss.fail()) throw runtime_error("estado de mt19937_64 inválido");
+    }
+
+private:
+    TipoRng tipo;
+    mt19937_64 mt;
+    Xoshiro256 xoshiro;
+};
+
+/*
+ * nombreRng
+ * - Recibe: tipo de generador
+ * - Retorna: nombre legible del algoritmo
+ */
+string nombreRng(TipoRng tipo) {
+    return (tipo == RNG_XOSHIRO) ? "xoshiro256**" : "mt19937_64";
+}
 
 /*
  * Coordenada
@@ -42,6 +186,68 @@ struct Coordenada {
     }
 };
 
+// Formato binario de instancias: firma, versión y cabecera de tamaño fijo
+const char FIRMA_INSTANCIA_BINARIA[8] = {'P', 'S', 'P', 'U', 'A', 'V', 'B', '\0'};
+const uint32_t VERSION_INSTANCIA_BINARIA = 2;
+
+/*
+ * CabeceraInstancia
+ * Cabecera de 32 bytes del formato binario. Le siguen, sin relleno y con
+ * n = filas * columnas: double tasas[n], uint64_t obstaculos[(n + 63) / 64],
+ * uint64_t urgencias[(n + 63) / 64] (celdas urgentes, también las de tasa 0),
+ * int32_t bases[2 * num_bases], int32_t distancia_base[n],
+ * int32_t distancia_urgencia[n] y uint16_t movimientos_validos[n]. Las tres
+ * últimas tablas son las de compilarTablasMovimiento, ya calculadas.
+ */
+struct CabeceraInstancia {
+    char firma[8];
+    uint32_t version;
+    int32_t filas;
+    int32_t columnas;
+    int32_t num_bases;
+    uint64_t reservado;
+};
+static_assert(sizeof(CabeceraInstancia) == 32, "la cabecera binaria debe ocupar 32 bytes");
+static_assert(sizeof(int) == sizeof(int32_t), "las distancias se copian como int32_t");
+
+/*
+ * ArchivoMapeado
+ * Archivo de solo lectura proyectado en memoria con mmap; se libera al destruirse.
+ */
+struct ArchivoMapeado {
+    const char* datos = nullptr;
+    size_t tamano = 0;
+
+    explicit ArchivoMapeado(const string& ruta) {
+        int fd = open(ruta.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw runtime_error("no se pudo abrir " + ruta);
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            close(fd);
+            throw runtime_error("no se pudo leer el tamaño de " + ruta);
+        }
+        tamano = info.st_size;
+        if (tamano > 0) {
+            void* mapa = mmap(nullptr, tamano, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapa == MAP_FAILED) {
+                close(fd);
+                throw runtime_error("no se pudo proyectar en memoria " + ruta);
+            }
+            datos = static_cast<const char*>(mapa);
+        }
+        close(fd);
+    }
+
+    ~ArchivoMapeado() {
+        if (datos) munmap(const_cast<char*>(datos), tamano);
+    }
+
+    ArchivoMapeado(const ArchivoMapeado&) = delete;
+    ArchivoMapeado& operator=(const ArchivoMapeado&) = delete;
+};
+
 /*
  * Instancia
  * Almacena toda la información del problema leída desde el archivo.
@@ -54,49 +260,478 @@ struct Instancia {
     map<Coordenada, double> tasas_urgencia;
     vector<Coordenada> bases;
     
+    // Representación densa precompilada (índice de celda = fila * columnas + col)
+    vector<uint8_t> mascara_celdas;     // CELDA_OBSTACULO | CELDA_BASE por celda
+    vector<int> indice_urgencia;        // celda -> índice de urgencia (-1 si no es urgente)
+    vector<int> celdas_urgentes;        // índice de urgencia -> celda
+    vector<double> tasas_densas;        // tasa de cada urgencia, en el mismo orden que tasas_urgencia
+    vector<uint64_t> bits_obstaculo;    // mapa de bits de obstáculos (bit = celda)
+    vector<uint64_t> bits_base;         // mapa de bits de bases (bit = celda)
+    vector<uint16_t> movimientos_validos;   // por celda: bit a = la acción a cae dentro de la grilla y fuera de obstáculos
+    vector<int> distancia_base;         // movimientos mínimos desde la base más cercana (-1 = inalcanzable)
+    vector<int> distancia_urgencia;     // movimientos mínimos a la urgencia alcanzable más cercana (-1 = ninguna)
+    
     /*
      * Constructor
-     * - Recibe: ruta del archivo de instancia
-     * Lee y carga todos los datos del problema desde el archivo.
+     * - Recibe: ruta del archivo de instancia (texto o binario)
+     * Detecta el formato por la firma inicial y carga todos los datos del problema.
+     * Lanza runtime_error si el archivo no existe o no es una instancia válida.
      * - Retorna: objeto Instancia inicializado
      */
     Instancia(const string& filename) {
+        char firma[sizeof(FIRMA_INSTANCIA_BINARIA)] = {};
+        {
+            ifstream file(filename, ios::binary);
+            if (!file) {
+                throw runtime_error("no se pudo abrir la instancia " + filename);
+            }
+            file.read(firma, sizeof(firma));
+        }
+        if (memcmp(firma, FIRMA_INSTANCIA_BINARIA, sizeof(firma)) == 0) {
+            cargarBinario(filename);
+        } else {
+            cargarTexto(filename);
+            compilarRepresentacionDensa();
+            compilarTablasMovimiento();
+        }
+    }
+    
+    /*
+     * cargarTexto
+     * - Recibe: ruta del archivo de texto
+     * Lee el formato de texto (GRID_ROWS, GRID_COLS, N_OBSTACLES, N_URGENCIES,
+     * N_BASES) validando etiquetas, cantidades, que cada número se pueda leer y
+     * que toda coordenada esté dentro de la grilla. Urgencias repetidas en la
+     * misma celda suman sus tasas.
+     * - Retorna: void (lanza runtime_error con el primer problema encontrado)
+     */
+    void cargarTexto(const string& filename) {
         ifstream file(filename);
-        string etiqueta;
+        auto error = [&](const string& detalle) {
+            return runtime_error(filename + ": " + detalle);
+        };
+        auto leerEntero = [&](const string& que) {
+            long valor;
+            if (!(file >> valor)) {
+                throw error(file.eof() ? "fin de archivo inesperado al leer " + que
+                                       : "valor no numérico en " + que);
+            }
+            if (valor < numeric_limits<int>::min() || valor > numeric_limits<int>::max()) {
+                throw error("valor fuera de rango en " + que);
+            }
+            return static_cast<int>(valor);
+        };
+        auto leerCantidad = [&](const string& etiqueta_esperada, int minimo) {
+            string etiqueta;
+            if (!(file >> etiqueta) || etiqueta != etiqueta_esperada) {
+                throw error("se esperaba " + etiqueta_esperada +
+                            (etiqueta.empty() ? "" : " y se encontró '" + etiqueta + "'"));
+            }
+            int valor = leerEntero(etiqueta_esperada);
+            if (valor < minimo) {
+                throw error(etiqueta_esperada + " debe ser al menos " + to_string(minimo) +
+                            " (es " + to_string(valor) + ")");
+            }
+            return valor;
+        };
+        auto leerCoordenada = [&](const string& que) {
+            Coordenada coord;
+            coord.fila = leerEntero(que);
+            coord.col = leerEntero(que);
+            if (!dentroDeGrilla(coord.fila, coord.col)) {
+                throw error(que + " fuera de la grilla: (" + to_string(coord.fila) + ", " +
+                            to_string(coord.col) + ")");
+            }
+            return coord;
+        };
         
-        file >> etiqueta >> filas;
-        file >> etiqueta >> columnas;
+        filas = leerCantidad("GRID_ROWS", 1);
+        columnas = leerCantidad("GRID_COLS", 1);
+        if (static_cast<long>(filas) * columnas > numeric_limits<int>::max()) {
+            throw error("grilla demasiado grande");
+        }
         
-        int n_obstaculos;
-        file >> etiqueta >> n_obstaculos;
+        int n_obstaculos = leerCantidad("N_OBSTACLES", 0);
         for (int i = 0; i < n_obstaculos; i++) {
-            int fila, col;
-            file >> fila >> col;
-            obstaculos.insert({fila, col});
+            obstaculos.insert(leerCoordenada("obstáculo " + to_string(i + 1)));
         }
         
-        int n_urgencias;
-        file >> etiqueta >> n_urgencias;
+        int n_urgencias = leerCantidad("N_URGENCIES", 0);
         for (int i = 0; i < n_urgencias; i++) {
-            int fila, col, urgencia;
-            file >> fila >> col >> urgencia;
-            Coordenada coord = {fila, col};
-            
-            if (tasas_urgencia.find(coord) == tasas_urgencia.end()) {
-                tasas_urgencia[coord] = 0.0;
+            string que = "urgencia " + to_string(i + 1);
+            Coordenada coord = leerCoordenada(que);
+            int urgencia = leerEntero(que);
+            if (urgencia < 0) {
+                throw error(que + " con tasa negativa (" + to_string(urgencia) + ")");
             }
             tasas_urgencia[coord] += static_cast<double>(urgencia);
         }
         
-        int n_bases;
-        file >> etiqueta >> n_bases;
+        int n_bases = leerCantidad("N_BASES", 1);
         for (int i = 0; i < n_bases; i++) {
-            int id, fila, col;
-            file >> id >> fila >> col;
-            bases.push_back({fila, col});
+            string que = "base " + to_string(i + 1);
+            leerEntero(que);  // id de la base (se usa la posición en la lista)
+            Coordenada coord = leerCoordenada(que);
+            if (obstaculos.count(coord)) {
+                throw error(que + " sobre un obstáculo");
+            }
+            bases.push_back(coord);
+        }
+    }
+    
+    /*
+     * cargarBinario
+     * - Recibe: ruta de un archivo en formato binario (ver CabeceraInstancia)
+     * Proyecta el archivo en memoria con mmap y copia los arreglos densos sin
+     * interpretar texto: las tasas por celda, los mapas de bits de obstáculos
+     * y de urgencias, la lista de bases y las tablas de movimientos y
+     * distancias precalculadas. Bases y tasas se validan como en cargarTexto y
+     * las tablas se verifican contra los obstáculos (verificarTablasMovimiento)
+     * en lugar de recalcularse.
+     * - Retorna: void (lanza runtime_error si el archivo está truncado o es inválido)
+     */
+    void cargarBinario(const string& filename) {
+        ArchivoMapeado archivo(filename);
+        auto error = [&](const string& detalle) {
+            return runtime_error(filename + ": " + detalle);
+        };
+        if (archivo.tamano < sizeof(CabeceraInstancia)) {
+            throw error("archivo binario truncado (sin cabecera)");
+        }
+        CabeceraInstancia cabecera;
+        memcpy(&cabecera, archivo.datos, sizeof(cabecera));
+        if (cabecera.version != VERSION_INSTANCIA_BINARIA) {
+            throw error("versión de formato binario " + to_string(cabecera.version) +
+                        " no soportada (se esperaba " + to_string(VERSION_INSTANCIA_BINARIA) + ")");
+        }
+        if (cabecera.filas < 1 || cabecera.columnas < 1 || cabecera.num_bases < 1 ||
+            static_cast<long>(cabecera.filas) * cabecera.columnas > numeric_limits<int>::max()) {
+            throw error("cabecera binaria inválida");
+        }
+        filas = cabecera.filas;
+        columnas = cabecera.columnas;
+        size_t num_celdas = static_cast<size_t>(filas) * columnas;
+        size_t palabras = (num_celdas + 63) / 64;
+        size_t esperado = sizeof(CabeceraInstancia) + num_celdas * sizeof(double) +
+                          2 * palabras * sizeof(uint64_t) + cabecera.num_bases * 2 * sizeof(int32_t) +
+                          num_celdas * (2 * sizeof(int32_t) + sizeof(uint16_t));
+        if (archivo.tamano != esperado) {
+            throw error("tamaño de archivo binario inconsistente con la cabecera");
+        }
+        
+        const char* cursor = archivo.datos + sizeof(CabeceraInstancia);
+        const double* tasas = reinterpret_cast<const double*>(cursor);
+        cursor += num_celdas * sizeof(double);
+        const uint64_t* obstaculo = reinterpret_cast<const uint64_t*>(cursor);
+        cursor += palabras * sizeof(uint64_t);
+        const uint64_t* urgente = reinterpret_cast<const uint64_t*>(cursor);
+        cursor += palabras * sizeof(uint64_t);
+        vector<int32_t> pos_bases(2 * cabecera.num_bases);
+        memcpy(pos_bases.data(), cursor, pos_bases.size() * sizeof(int32_t));
+        cursor += pos_bases.size() * sizeof(int32_t);
+        distancia_base.resize(num_celdas);
+        memcpy(distancia_base.data(), cursor, num_celdas * sizeof(int32_t));
+        cursor += num_celdas * sizeof(int32_t);
+        distancia_urgencia.resize(num_celdas);
+        memcpy(distancia_urgencia.data(), cursor, num_celdas * sizeof(int32_t));
+        cursor += num_celdas * sizeof(int32_t);
+        movimientos_validos.resize(num_celdas);
+        memcpy(movimientos_validos.data(), cursor, num_celdas * sizeof(uint16_t));
+        
+        // Las celdas se recorren en orden fila-mayor, que es el orden de Coordenada
+        for (size_t celda = 0; celda < num_celdas; ++celda) {
+            Coordenada coord = {static_cast<int>(celda / columnas), static_cast<int>(celda % columnas)};
+            if ((obstaculo[celda >> 6] >> (celda & 63)) & 1) {
+                obstaculos.insert(obstaculos.end(), coord);
+            }
+            if ((urgente[celda >> 6] >> (celda & 63)) & 1) {
+                if (!(tasas[celda] >= 0.0) || !isfinite(tasas[celda])) {
+                    throw error("urgencia en (" + to_string(coord.fila) + ", " + to_string(coord.col) +
+                                ") con tasa negativa o no finita");
+                }
+                tasas_urgencia.emplace_hint(tasas_urgencia.end(), coord, tasas[celda]);
+            } else if (tasas[celda] != 0.0) {
+                throw error("tasa en una celda sin urgencia");
+            }
+        }
+        for (int i = 0; i < cabecera.num_bases; ++i) {
+            string que = "base " + to_string(i + 1);
+            Coordenada coord = {pos_bases[2 * i], pos_bases[2 * i + 1]};
+            if (!dentroDeGrilla(coord.fila, coord.col)) {
+                throw error(que + " fuera de la grilla");
+            }
+            if (obstaculos.count(coord)) {
+                throw error(que + " sobre un obstáculo");
+            }
+            bases.push_back(coord);
+        }
+        compilarRepresentacionDensa();
+        verificarTablasMovimiento(filename);
+    }
+    
+    /*
+     * verificarTablasMovimiento
+     * - Recibe: ruta del archivo (para los mensajes)
+     * Comprueba que las tablas leídas de un archivo binario sean las que
+     * calcularía compilarTablasMovimiento sin repetir los BFS: la máscara de
+     * cada celda se compara con la recalculada y cada tabla de distancias se
+     * valida localmente (ver distanciasConsistentes).
+     * - Retorna: void (lanza runtime_error si alguna tabla no corresponde)
+     */
+    void verificarTablasMovimiento(const string& filename) const {
+        int num_celdas = filas * columnas;
+        for (int fila = 0; fila < filas; ++fila) {
+            for (int col = 0; col < columnas; ++col) {
+                uint16_t mascara = 0;
+                for (int a = 0; a < 9; ++a) {
+                    int nf = fila + DELTA_FILA[a];
+                    int nc = col + DELTA_COL[a];
+                    if (dentroDeGrilla(nf, nc) && !(mascara_celdas[indiceCelda(nf, nc)] & CELDA_OBSTACULO)) {
+                        mascara |= 1 << a;
+                    }
+                }
+                if (movimientos_validos[indiceCelda(fila, col)] != mascara) {
+                    throw runtime_error(filename + ": tabla de movimientos válidos inconsistente con los obstáculos");
+                }
+            }
+        }
+        
+        vector<uint8_t> origen(num_celdas, 0);
+        for (const Coordenada& base : bases) origen[indiceCelda(base.fila, base.col)] = 1;
+        if (!distanciasConsistentes(distancia_base, origen)) {
+            throw runtime_error(filename + ": tabla de distancias a las bases inconsistente");
+        }
+        origen.assign(num_celdas, 0);
+        for (int celda : celdas_urgentes) {
+            if (distancia_base[celda] >= 0) origen[celda] = 1;
+        }
+        if (!distanciasConsistentes(distancia_urgencia, origen)) {
+            throw runtime_error(filename + ": tabla de distancias a las urgencias inconsistente");
+        }
+    }
+    
+    /*
+     * distanciasConsistentes
+     * - Recibe: tabla de distancias, marca de las celdas de origen
+     * Los orígenes están a 0 y ninguna otra celda; los obstáculos son
+     * inalcanzables; las vecinas de una celda alcanzable también lo son y
+     * están a lo sumo a un paso de diferencia; y cada distancia positiva tiene
+     * una vecina a un paso menos. Como los movimientos son simétricos, solo la
+     * distancia BFS exacta cumple las cuatro condiciones.
+     * - Retorna: true si la tabla es la del BFS desde esos orígenes
+     */
+    bool distanciasConsistentes(const vector<int>& distancia, const vector<uint8_t>& origen) const {
+        for (int celda = 0; celda < filas * columnas; ++celda) {
+            int d = distancia[celda];
+            if (origen[celda] ? d != 0 : (d == 0 || d < -1)) return false;
+            if (d < 0) continue;
+            if (mascara_celdas[celda] & CELDA_OBSTACULO) return false;
+            bool predecesora = (d == 0);
+            uint16_t mascara = movimientos_validos[celda];
+            for (int a = 1; a < 9; ++a) {
+                if (!(mascara & (1 << a))) continue;
+                int dv = distancia[indiceCelda(celda / columnas + DELTA_FILA[a], celda % columnas + DELTA_COL[a])];
+                if (dv < 0 || dv > d + 1 || dv < d - 1) return false;
+                if (dv == d - 1) predecesora = true;
+            }
+            if (!predecesora) return false;
+        }
+        return true;
+    }
+    
+    /*
+     * guardarBinario
+     * - Recibe: ruta de salida
+     * Escribe la instancia en el formato binario descrito en CabeceraInstancia,
+     * en el orden de bytes de la máquina.
+     * - Retorna: void (lanza runtime_error si no se puede escribir)
+     */
+    void guardarBinario(const string& ruta) const {
+        int num_celdas = filas * columnas;
+        vector<double> tasas(num_celdas, 0.0);
+        vector<uint64_t> bits_urgencia((num_celdas + 63) / 64, 0);
+        for (size_t u = 0; u < celdas_urgentes.size(); ++u) {
+            int celda = celdas_urgentes[u];
+            tasas[celda] = tasas_densas[u];
+            bits_urgencia[celda >> 6] |= uint64_t(1) << (celda & 63);
+        }
+        vector<int32_t> pos_bases;
+        for (const Coordenada& base : bases) {
+            pos_bases.push_back(base.fila);
+            pos_bases.push_back(base.col);
+        }
+        
+        CabeceraInstancia cabecera = {};
+        memcpy(cabecera.firma, FIRMA_INSTANCIA_BINARIA, sizeof(cabecera.firma));
+        cabecera.version = VERSION_INSTANCIA_BINARIA;
+        cabecera.filas = filas;
+        cabecera.columnas = columnas;
+        cabecera.num_bases = bases.size();
+        
+        ofstream archivo(ruta, ios::binary);
+        archivo.write(reinterpret_cast<const char*>(&cabecera), sizeof(cabecera));
+        archivo.write(reinterpret_cast<const char*>(tasas.data()), tasas.size() * sizeof(double));
+        archivo.write(reinterpret_cast<const char*>(bits_obstaculo.data()),
+                      bits_obstaculo.size() * sizeof(uint64_t));
+        archivo.write(reinterpret_cast<const char*>(bits_urgencia.data()),
+                      bits_urgencia.size() * sizeof(uint64_t));
+        archivo.write(reinterpret_cast<const char*>(pos_bases.data()), pos_bases.size() * sizeof(int32_t));
+        archivo.write(reinterpret_cast<const char*>(distancia_base.data()), num_celdas * sizeof(int32_t));
+        archivo.write(reinterpret_cast<const char*>(distancia_urgencia.data()), num_celdas * sizeof(int32_t));
+        archivo.write(reinterpret_cast<const char*>(movimientos_validos.data()), num_celdas * sizeof(uint16_t));
+        if (!archivo) {
+            throw runtime_error("no se pudo escribir " + ruta);
+        }
+    }
+    
+    /*
+     * huella
+     * - Recibe: nada
+     * Resume dimensiones, obstáculos, bases y urgencias con sus tasas.
+     * - Retorna: hash de 64 bits del contenido de la instancia (para
+     *   comprobar que un checkpoint se reanuda sobre la misma instancia)
+     */
+    uint64_t huella() const {
+        auto mezclar = [](uint64_t h, uint64_t v) {
+            h = (h ^ v) * 0x9E3779B97F4A7C15ULL;
+            return h ^ (h >> 29);
+        };
+        uint64_t h = mezclar(0x13198A2E03707344ULL, (static_cast<uint64_t>(filas) << 32) | columnas);
+        for (uint64_t palabra : bits_obstaculo) h = mezclar(h, palabra);
+        for (const Coordenada& base : bases) h = mezclar(h, (static_cast<uint64_t>(base.fila) << 32) | base.col);
+        for (size_t u = 0; u < tasas_densas.size(); ++u) {
+            uint64_t tasa;
+            memcpy(&tasa, &tasas_densas[u], sizeof(tasa));
+            h = mezclar(mezclar(h, static_cast<uint32_t>(celdas_urgentes[u])), tasa);
+        }
+        return h;
+    }
+    
+    /*
+     * dentroDeGrilla
+     * - Recibe: fila y columna
+     * Verifica si la posición está dentro de los límites de la grilla.
+     * - Retorna: true si está dentro
+     */
+    bool dentroDeGrilla(int fila, int col) const {
+        return fila >= 0 && fila < filas && col >= 0 && col < columnas;
+    }
+    
+    /*
+     * indiceCelda
+     * - Recibe: fila y columna (dentro de la grilla)
+     * - Retorna: índice de la celda en orden fila-mayor
+     */
+    int indiceCelda(int fila, int col) const {
+        return fila * columnas + col;
+    }
+    
+    /*
+     * compilarRepresentacionDensa
+     * - Recibe: nada (usa obstáculos, bases y tasas ya cargadas; los cargadores
+     *   garantizan que todas sus coordenadas están dentro de la grilla)
+     * Construye las tablas planas usadas por MotorEvaluacion. Las urgencias se
+     * numeran en el orden del map (fila, col), que coincide con el orden
+     * fila-mayor, para que las sumas se hagan en el mismo orden que antes.
+     * - Retorna: void
+     */
+    void compilarRepresentacionDensa() {
+        int num_celdas = filas * columnas;
+        mascara_celdas.assign(num_celdas, 0);
+        indice_urgencia.assign(num_celdas, -1);
+        bits_obstaculo.assign((num_celdas + 63) / 64, 0);
+        bits_base.assign((num_celdas + 63) / 64, 0);
+        celdas_urgentes.clear();
+        tasas_densas.clear();
+        
+        for (const Coordenada& obs : obstaculos) {
+            int celda = indiceCelda(obs.fila, obs.col);
+            mascara_celdas[celda] |= CELDA_OBSTACULO;
+            bits_obstaculo[celda >> 6] |= uint64_t(1) << (celda & 63);
+        }
+        for (const Coordenada& base : bases) {
+            int celda = indiceCelda(base.fila, base.col);
+            mascara_celdas[celda] |= CELDA_BASE;
+            bits_base[celda >> 6] |= uint64_t(1) << (celda & 63);
+        }
+        for (const auto& par : tasas_urgencia) {
+            int celda = indiceCelda(par.first.fila, par.first.col);
+            indice_urgencia[celda] = celdas_urgentes.size();
+            celdas_urgentes.push_back(celda);
+            tasas_densas.push_back(par.second);
+        }
+    }
+    
+    /*
+     * compilarTablasMovimiento
+     * - Recibe: nada (usa la representación densa ya construida)
+     * Calcula la máscara de acciones válidas de cada celda (dentro de la grilla
+     * y sin obstáculo en el destino) y, con BFS sobre esos movimientos, la
+     * distancia de cada celda a la base más cercana y a la urgencia más cercana
+     * que sea alcanzable desde alguna base.
+     * - Retorna: void
+     */
+    void compilarTablasMovimiento() {
+        int num_celdas = filas * columnas;
+        movimientos_validos.assign(num_celdas, 0);
+        for (int fila = 0; fila < filas; ++fila) {
+            for (int col = 0; col < columnas; ++col) {
+                uint16_t mascara = 0;
+                for (int a = 0; a < 9; ++a) {
+                    int nf = fila + DELTA_FILA[a];
+                    int nc = col + DELTA_COL[a];
+                    if (dentroDeGrilla(nf, nc) && !(mascara_celdas[indiceCelda(nf, nc)] & CELDA_OBSTACULO)) {
+                        mascara |= 1 << a;
+                    }
+                }
+                movimientos_validos[indiceCelda(fila, col)] = mascara;
+            }
+        }
+        
+        vector<int> origenes;
+        for (const Coordenada& base : bases) {
+            origenes.push_back(indiceCelda(base.fila, base.col));
         }
+        calcularDistancias(origenes, distancia_base);
         
-        file.close();
+        origenes.clear();
+        for (int celda : celdas_urgentes) {
+            if (distancia_base[celda] >= 0) origenes.push_back(celda);
+        }
+        calcularDistancias(origenes, distancia_urgencia);
+    }
+    
+    /*
+     * calcularDistancias
+     * - Recibe: celdas de origen, vector destino
+     * BFS multiorigen con los movimientos de 8 vecinos permitidos por
+     * movimientos_validos (los movimientos son simétricos).
+     * - Retorna: void (distancia[celda] = movimientos mínimos, -1 si inalcanzable)
+     */
+    void calcularDistancias(const vector<int>& origenes, vector<int>& distancia) const {
+        distancia.assign(filas * columnas, -1);
+        vector<int> cola;
+        cola.reserve(filas * columnas);
+        for (int celda : origenes) {
+            if (distancia[celda] < 0) {
+                distancia[celda] = 0;
+                cola.push_back(celda);
+            }
+        }
+        for (size_t i = 0; i < cola.size(); ++i) {
+            int celda = cola[i];
+            int fila = celda / columnas;
+            int col = celda % columnas;
+            uint16_t mascara = movimientos_validos[celda];
+            for (int a = 1; a < 9; ++a) {
+                if (!(mascara & (1 << a))) continue;
+                int vecina = indiceCelda(fila + DELTA_FILA[a], col + DELTA_COL[a]);
+                if (distancia[vecina] < 0) {
+                    distancia[vecina] = distancia[celda] + 1;
+                    cola.push_back(vecina);
+                }
+            }
+        }
     }
 };
 
@@ -104,22 +739,61 @@ struct Instancia {
  * Individuo
  * Representa una solución candidata (cromosoma) del algoritmo evolutivo.
  * Se usa para almacenar el plan de vuelo completo de k drones por T ticks.
+ * Las acciones (0-8) se guardan como bytes en un único buffer contiguo,
+ * ordenado por dron: la acción del dron d en el tick t está en d * ticks + t.
  */
 struct Individuo {
     vector<int> base_ids;
-    vector<vector<int>> acciones;
+    vector<uint8_t> acciones;
+    int ticks = 0;                      // paso entre drones dentro de acciones
     double fitness;
     bool es_valido;
     
+    // Puntos de control de la simulación (los llena MotorEvaluacion si tiene presupuesto).
+    // El punto j (1..controles_validos) es el estado al inicio del tick j * intervalo_control.
+    int intervalo_control = 0;
+    int controles_validos = 0;
+    vector<int> control_posiciones;     // 2k enteros (fila, col) por punto
+    vector<double> control_urgencias;   // una urgencia por celda urgente y punto
+    vector<double> control_acumulado;   // urgencia acumulada en cada punto
+    
+    /*
+     * accion
+     * - Recibe: dron d, tick t
+     * - Retorna: referencia a la acción del dron d en el tick t
+     */
+    uint8_t& accion(int d, int t) { return acciones[static_cast<size_t>(d) * ticks + t]; }
+    uint8_t accion(int d, int t) const { return acciones[static_cast<size_t>(d) * ticks + t]; }
+    
+    /*
+     * plan
+     * - Recibe: dron d
+     * - Retorna: puntero a las T acciones consecutivas del dron d
+     */
+    uint8_t* plan(int d) { return acciones.data() + static_cast<size_t>(d) * ticks; }
+    const uint8_t* plan(int d) const { return acciones.data() + static_cast<size_t>(d) * ticks; }
+    
+    /*
+     * redimensionar
+     * - Recibe: número de drones (k), número de ticks (T)
+     * Ajusta el cromosoma a k x T reutilizando la memoria ya reservada.
+     * - Retorna: void
+     */
+    void redimensionar(int k, int T) {
+        ticks = T;
+        base_ids.resize(k);
+        acciones.resize(static_cast<size_t>(k) * T);
+        controles_validos = 0;
+    }
+    
     /*
      * inicializarAleatorio
-     * - Recibe: número de drones (k), número de ticks (T), instancia del problema
+     * - Recibe: número de drones (k), número de ticks (T), instancia del problema, generador
      * Genera un plan de vuelo aleatorio para todos los drones.
      * - Retorna: void (modifica el individuo actual)
      */
-    void inicializarAleatorio(int k, int T, const Instancia& inst) {
-        base_ids.clear();
-        acciones.clear();
+    void inicializarAleatorio(int k, int T, const Instancia& inst, GeneradorRng& gen) {
+        redimensionar(k, T);
         fitness = 0.0;
         es_valido = false;
         
@@ -128,19 +802,16 @@ struct Individuo {
         
         // Asignar bases aleatorias
         for (int i = 0; i < k; i++) {
-            int base_id = dist_base(rng);
-            base_ids.push_back(base_id);
+            base_ids[i] = dist_base(gen);
         }
         
         // Generar acciones aleatorias (0=Stay, 1=N, 2=NE, 3=E, 4=SE, 5=S, 6=SW, 7=W, 8=NW)
         uniform_int_distribution<int> dist_accion(0, 8);
         for (int i = 0; i < k; i++) {
-            vector<int> plan_dron;
+            uint8_t* plan_dron = plan(i);
             for (int t = 0; t < T; t++) {
-                int accion = dist_accion(rng);
-                plan_dron.push_back(accion);
+                plan_dron[t] = dist_accion(gen);
             }
-            acciones.push_back(plan_dron);
         }
     }
 };
@@ -199,13 +870,14 @@ Coordenada aplicarAccion(const Coordenada& pos, int accion) {
 }
 
 /*
- * calcularFitness
+ * calcularFitnessReferencia
  * - Recibe: individuo a evaluar, instancia del problema, horizonte temporal T
- * Simula el plan de vuelo y calcula la urgencia acumulada total.
+ * Simulador original basado en map/set. Ya no se usa en el ciclo evolutivo;
+ * se conserva como referencia para verificar MotorEvaluacion (--verificar).
  * Aplica penalización gradual para soluciones inválidas (mejor que penalización fija).
  * - Retorna: void (modifica fitness y es_valido del individuo)
  */
-void calcularFitness(Individuo& ind, const Instancia& inst, int T) {
+void calcularFitnessReferencia(Individuo& ind, const Instancia& inst, int T) {
     int k = ind.base_ids.size();
     double urgencia_acumulada_total = 0.0;
     
@@ -257,7 +929,7 @@ void calcularFitness(Individuo& ind, const Instancia& inst, int T) {
         };
         
         for (int d = 0; d < k; d++) {
-            int accion = ind.acciones[d][t];
+            int accion = ind.accion(d, t);
             Coordenada nueva_pos = aplicarAccion(pos_drones[d], accion);
             
             // Verificar colisión (permitida SOLO en bases)
@@ -305,356 +977,4802 @@ void calcularFitness(Individuo& ind, const Instancia& inst, int T) {
 }
 
 /*
- * AlgoritmoEvolutivo
- * Gestiona la población de individuos y ejecuta el proceso evolutivo.
- * Se usa para encontrar la mejor solución mediante selección, cruce y mutación.
+ * KernelUrgencia
+ * Kernel fusionado del paso de urgencias de un tick: suma urgencia[0..n) y
+ * luego le agrega a cada celda su tasa. Las celdas vigiladas se vuelven a
+ * poner en 0 después, a partir de la lista de visitadas, por lo que no hace
+ * falta enmascararlas aquí.
+ * - Retorna: suma de las urgencias antes de incrementarlas
  */
-class AlgoritmoEvolutivo {
-public:
-    vector<Individuo> poblacion;
-    int tam_poblacion;
-    double tasa_mutacion;
-    int k_drones;
-    int T_ticks;
-    const Instancia& inst;
+using KernelUrgencia = double (*)(double* urgencia, const double* tasas, int n);
+
+double kernelUrgenciaEscalar(double* urgencia, const double* tasas, int n) {
+    double suma = 0.0;
+    for (int u = 0; u < n; u++) {
+        suma += urgencia[u];
+        urgencia[u] += tasas[u];
+    }
+    return suma;
+}
 
-    AlgoritmoEvolutivo(int pop_size, double mut_rate, int k, int T, const Instancia& inst_ref)
-        : tam_poblacion(pop_size), tasa_mutacion(mut_rate), k_drones(k), T_ticks(T), inst(inst_ref) {}
+#ifdef PSP_X86
+__attribute__((target("sse2")))
+double kernelUrgenciaSSE2(double* urgencia, const double* tasas, int n) {
+    __m128d suma0 = _mm_setzero_pd();
+    __m128d suma1 = _mm_setzero_pd();
+    int u = 0;
+    for (; u + 4 <= n; u += 4) {
+        __m128d a = _mm_loadu_pd(urgencia + u);
+        __m128d b = _mm_loadu_pd(urgencia + u + 2);
+        suma0 = _mm_add_pd(suma0, a);
+        suma1 = _mm_add_pd(suma1, b);
+        _mm_storeu_pd(urgencia + u, _mm_add_pd(a, _mm_loadu_pd(tasas + u)));
+        _mm_storeu_pd(urgencia + u + 2, _mm_add_pd(b, _mm_loadu_pd(tasas + u + 2)));
+    }
+    double parcial[2];
+    _mm_storeu_pd(parcial, _mm_add_pd(suma0, suma1));
+    double suma = parcial[0] + parcial[1];
+    for (; u < n; u++) {
+        suma += urgencia[u];
+        urgencia[u] += tasas[u];
+    }
+    return suma;
+}
 
-    /*
-     * inicializarPoblacion
-     * - Recibe:
-     * Crea la población inicial con individuos aleatorios y los evalúa.
-     * - Retorna: modifica la población
-     */
-    void inicializarPoblacion() {
-        poblacion.clear();
-        for (int i = 0; i < tam_poblacion; ++i) {
-            Individuo ind;
-            ind.inicializarAleatorio(k_drones, T_ticks, inst);
-            repararIndividuo(ind); // Garantizar población inicial válida
-            calcularFitness(ind, inst, T_ticks);
-            poblacion.push_back(ind);
+__attribute__((target("avx2")))
+double kernelUrgenciaAVX2(double* urgencia, const double* tasas, int n) {
+    __m256d suma0 = _mm256_setzero_pd();
+    __m256d suma1 = _mm256_setzero_pd();
+    int u = 0;
+    for (; u + 8 <= n; u += 8) {
+        __m256d a = _mm256_loadu_pd(urgencia + u);
+        __m256d b = _mm256_loadu_pd(urgencia + u + 4);
+        suma0 = _mm256_add_pd(suma0, a);
+        suma1 = _mm256_add_pd(suma1, b);
+        _mm256_storeu_pd(urgencia + u, _mm256_add_pd(a, _mm256_loadu_pd(tasas + u)));
+        _mm256_storeu_pd(urgencia + u + 4, _mm256_add_pd(b, _mm256_loadu_pd(tasas + u + 4)));
+    }
+    double parcial[4];
+    _mm256_storeu_pd(parcial, _mm256_add_pd(suma0, suma1));
+    double suma = (parcial[0] + parcial[1]) + (parcial[2] + parcial[3]);
+    for (; u < n; u++) {
+        suma += urgencia[u];
+        urgencia[u] += tasas[u];
+    }
+    return suma;
+}
+#endif
+
+/*
+ * kernelUrgenciaPorNombre
+ * - Recibe: nombre del kernel ("escalar", "sse2", "avx2" o "auto")
+ * Con "auto" elige en tiempo de ejecución el mejor soportado por la CPU.
+ * - Retorna: puntero al kernel (nullptr si no existe o la CPU no lo soporta)
+ */
+KernelUrgencia kernelUrgenciaPorNombre(const string& nombre) {
+#ifdef PSP_X86
+    bool hay_avx2 = __builtin_cpu_supports("avx2");
+    bool hay_sse2 = __builtin_cpu_supports("sse2");
+    if (nombre == "avx2") return hay_avx2 ? kernelUrgenciaAVX2 : nullptr;
+    if (nombre == "sse2") return hay_sse2 ? kernelUrgenciaSSE2 : nullptr;
+    if (nombre == "auto") {
+        if (hay_avx2) return kernelUrgenciaAVX2;
+        if (hay_sse2) return kernelUrgenciaSSE2;
+    }
+#endif
+    if (nombre == "escalar" || nombre == "auto") return kernelUrgenciaEscalar;
+    return nullptr;
+}
+
+// Kernel usado por defecto por MotorEvaluacion (se puede cambiar con --kernel)
+KernelUrgencia kernel_urgencia_defecto = kernelUrgenciaPorNombre("auto");
+
+// Evaluador de urgencias por defecto de MotorEvaluacion (--evaluador perezoso)
+bool evaluacion_perezosa_defecto = false;
+
+// Individuos que MotorEvaluacion::evaluarLote simula intercalados tick a tick
+const int ANCHO_LOTE = 4;
+
+// Memoria de urgencias que pueden ocupar juntos los carriles de un lote: con
+// muchas urgencias se usan menos carriles para no desbordar la caché L2
+const size_t BYTES_URGENCIA_LOTE = 256 * 1024;
+
+/*
+ * TareaEvaluacion
+ * Individuo pendiente de evaluar dentro de un lote. Si tiene padre, la
+ * simulación puede reanudarse desde sus puntos de control (ver evaluarDesde).
+ */
+struct TareaEvaluacion {
+    Individuo* ind;
+    const Individuo* padre;     // nullptr = simular desde las bases
+    int tick_modificado;        // primer tick en que ind difiere de padre
+};
+
+/*
+ * EstadoSimulacion
+ * Estado de la misión al inicio de una ventana del horizonte rodante: bases
+ * asignadas, posición de cada dron y urgencia de cada celda urgente (en el
+ * orden de Instancia::tasas_densas). Con él la simulación puede empezar en
+ * cualquier tick en lugar de hacerlo en las bases con urgencias en cero.
+ */
+struct EstadoSimulacion {
+    vector<int> base_ids;
+    vector<Coordenada> posiciones;
+    vector<double> urgencia;
+};
+
+/*
+ * MotorEvaluacion
+ * Simulador de planes sobre la representación densa de la Instancia.
+ * Se usa como kernel de fitness: mantiene buffers de trabajo reutilizables
+ * (urgencias, lista de visitadas y ocupación) para no reservar memoria por tick.
+ * Con el kernel escalar produce exactamente los mismos valores que
+ * calcularFitnessReferencia; los kernels SIMD reordenan la suma de urgencias
+ * (idéntico si las tasas son enteras, si no dentro de la tolerancia de punto flotante).
+ * Con presupuesto de puntos de control > 0 guarda el estado de la simulación en
+ * el individuo cada cierto intervalo, para poder reanudar la evaluación de un
+ * hijo desde el primer tick en que difiere de su padre (evaluarDesde).
+ * Los lotes se simulan en hasta ANCHO_LOTE carriles que avanzan un tick por
+ * turno, de modo que las latencias de memoria de un individuo se solapan con
+ * el trabajo de los demás. Cada carril recorre su propio arreglo de
+ * urgencias, así que el ancho se reduce para que los carriles juntos no
+ * superen BYTES_URGENCIA_LOTE. En las instancias incluidas el intercalado
+ * rinde lo mismo que evaluar de a uno (tabla evaluacion_lote del benchmark);
+ * limitar el ancho evita que sea más lento en grillas grandes.
+ * En modo perezoso no recorre las U celdas urgentes en cada tick: guarda para
+ * cada una el tick desde el que crece sin resetearse y, al visitarla, suma en
+ * forma cerrada lo que aportó en esos ticks (serie aritmética de su tasa). Un
+ * tick cuesta O(k) y el horizonte se cierra con un barrido O(U). Con tasas
+ * enteras da exactamente los mismos valores que el modo denso.
+ */
+class MotorEvaluacion {
+public:
+    explicit MotorEvaluacion(const Instancia& inst_ref, int max_controles = 0)
+        : inst(inst_ref),
+          carriles(max<size_t>(1, min<size_t>(ANCHO_LOTE, BYTES_URGENCIA_LOTE /
+                                          max<size_t>(1, inst_ref.tasas_densas.size() * sizeof(double))))),
+          ocupacion((inst_ref.mascara_celdas.size() + 63) / 64, 0),
+          kernel(kernel_urgencia_defecto),
+          perezoso(evaluacion_perezosa_defecto),
+          presupuesto_controles(max(0, max_controles)),
+          estado_inicial(nullptr),
+          urgencia_inicial_total(0.0),
+          tasas_total(accumulate(inst_ref.tasas_densas.begin(), inst_ref.tasas_densas.end(), 0.0)),
+          evaluaciones(0),
+          ticks_simulados(0) {
+        for (Carril& c : carriles) {
+            c.urgencia.assign(inst_ref.tasas_densas.size(), 0.0);
+            c.ultimo.assign(inst_ref.tasas_densas.size(), 0);
         }
     }
 
     /*
-     * seleccionarPorTorneo
-     * - Recibe: tamaño del torneo
-     * Selecciona un individuo mediante torneo (compara individuos aleatorios).
-     * - Retorna: referencia al mejor individuo del torneo
+     * evaluar
+     * - Recibe: individuo a evaluar, horizonte temporal T
+     * Simula el plan completo desde las bases con la misma semántica que el
+     * simulador de referencia (acumular, incrementar no visitadas, mover/validar, resetear).
+     * - Retorna: void (modifica fitness, es_valido y puntos de control del individuo)
      */
-    const Individuo& seleccionarPorTorneo(int tam_torneo) {
-        uniform_int_distribution<int> dist_pop(0, tam_poblacion - 1);
-        const Individuo* mejor_del_torneo = &poblacion[dist_pop(rng)];
-
-        for (int i = 1; i < tam_torneo; ++i) {
-            const Individuo* retador = &poblacion[dist_pop(rng)];
-            if (retador->fitness < mejor_del_torneo->fitness) {
-                mejor_del_torneo = retador;
-            }
-        }
-        return *mejor_del_torneo;
+    void evaluar(Individuo& ind, int T) {
+        TareaEvaluacion tarea = {&ind, nullptr, 0};
+        evaluarLote(&tarea, 1, T);
     }
 
     /*
-     * cruzarUnPunto
-     * - Recibe: dos individuos padres
-     * Crea un hijo combinando acciones de ambos padres en un punto de corte temporal.
-     * - Retorna: nuevo individuo hijo
+     * evaluarDesde
+     * - Recibe: hijo a evaluar, padre con las mismas bases y las mismas acciones
+     *   en los ticks [0, tick_modificado), horizonte temporal T
+     * Reanuda la simulación desde el último punto de control del padre que no
+     * supera tick_modificado; si no hay ninguno usable, evalúa desde cero.
+     * - Retorna: void (modifica fitness, es_valido y puntos de control del hijo)
      */
-    Individuo cruzarUnPunto(const Individuo& p1, const Individuo& p2) {
-        Individuo hijo;
-        hijo.base_ids = p1.base_ids;
-        hijo.acciones.resize(k_drones, vector<int>(T_ticks));
+    void evaluarDesde(Individuo& hijo, const Individuo& padre, int tick_modificado, int T) {
+        TareaEvaluacion tarea = {&hijo, &padre, tick_modificado};
+        evaluarLote(&tarea, 1, T);
+    }
 
-        uniform_int_distribution<int> dist_corte(1, T_ticks - 2);
-        int punto_corte_t = dist_corte(rng);
+    /*
+     * reconstruirControles
+     * - Recibe: individuo ya evaluado, horizonte temporal T
+     * Vuelve a simular el plan solo para guardar sus puntos de control. No
+     * cuenta como evaluación: el fitness no cambia, y así el conteo no depende
+     * de si el individuo conservaba sus puntos de control (un checkpoint no
+     * los guarda).
+     * - Retorna: void (modifica los puntos de control del individuo)
+     */
+    void reconstruirControles(Individuo& ind, int T) {
+        evaluar(ind, T);
+        evaluaciones--;
+    }
 
-        for (int d = 0; d < k_drones; ++d) {
-            for (int t = 0; t < punto_corte_t; ++t) {
-                hijo.acciones[d][t] = p1.acciones[d][t];
+    /*
+     * evaluarLote
+     * - Recibe: arreglo de n tareas, horizonte temporal T
+     * Evalúa todas las tareas intercalándolas: cada carril avanza un tick por
+     * turno y, cuando su individuo termina (fin del horizonte o plan inválido),
+     * toma la siguiente tarea pendiente.
+     * - Retorna: void (modifica fitness, es_valido y puntos de control de cada individuo)
+     */
+    void evaluarLote(TareaEvaluacion* tareas, int n, int T) {
+        int siguiente = 0;
+        int activos = 0;
+        for (Carril& c : carriles) {
+            c.ind = nullptr;
+            if (siguiente < n) {
+                iniciarCarril(c, tareas[siguiente++], T);
+                activos++;
             }
-            for (int t = punto_corte_t; t < T_ticks; ++t) {
-                hijo.acciones[d][t] = p2.acciones[d][t];
+        }
+        
+        while (activos > 0) {
+            for (Carril& c : carriles) {
+                if (!c.ind || avanzarTick(c, T)) continue;
+                c.ind = nullptr;
+                activos--;
+                if (siguiente < n) {
+                    iniciarCarril(c, tareas[siguiente++], T);
+                    activos++;
+                }
             }
         }
-        return hijo;
+        evaluaciones += n;
     }
 
     /*
-     * generarAccionValida
-     * - Recibe: posición actual del dron
-     * Genera una acción aleatoria que NO saque al dron fuera de la grilla.
-     * - Retorna: código de acción válida (0-8)
+     * fijarEstadoInicial
+     * - Recibe: estado desde el que empiezan las simulaciones (nullptr = bases
+     *   con urgencias en cero); debe seguir vivo mientras se use el motor
+     * - Retorna: void
      */
-    int generarAccionValida(const Coordenada& pos) {
-        vector<int> acciones_validas;
-        acciones_validas.push_back(0); // Permanecer siempre es válido
-        
-        // Verificar cada dirección antes de agregarla como válida
-        if (pos.fila > 0) {
-            acciones_validas.push_back(1); // Arriba
-            if (pos.col < inst.columnas - 1) acciones_validas.push_back(2); // Arriba-Derecha
-            if (pos.col > 0) acciones_validas.push_back(8); // Arriba-Izquierda
-        }
-        
-        if (pos.col < inst.columnas - 1) {
-            acciones_validas.push_back(3); // Derecha
-            if (pos.fila < inst.filas - 1) acciones_validas.push_back(4); // Abajo-Derecha
-        }
-        
-        if (pos.fila < inst.filas - 1) {
-            acciones_validas.push_back(5); // Abajo
-            if (pos.col > 0) acciones_validas.push_back(6); // Abajo-Izquierda
+    void fijarEstadoInicial(const EstadoSimulacion* estado) {
+        estado_inicial = estado;
+        urgencia_inicial_total = estado ? accumulate(estado->urgencia.begin(), estado->urgencia.end(), 0.0) : 0.0;
+    }
+
+    /*
+     * iniciarPorTicks
+     * - Recibe: individuo cuyo plan se irá escribiendo tick a tick, horizonte T
+     * Prepara una simulación incremental desde el estado inicial: el llamador
+     * escribe las acciones de todos los drones para el tick t y luego llama a
+     * simularTick. No puede mezclarse con evaluarLote en el mismo motor.
+     * - Retorna: void
+     */
+    void iniciarPorTicks(Individuo& ind, int T) {
+        iniciarCarril(carriles[0], {&ind, nullptr, 0}, T);
+    }
+
+    /*
+     * simularTick
+     * - Recibe: horizonte T
+     * Simula el siguiente tick de la simulación iniciada con iniciarPorTicks
+     * (llamado con t = T escribe el fitness final).
+     * - Retorna: true si la simulación sigue, false si terminó (fitness escrito)
+     */
+    bool simularTick(int T) {
+        if (avanzarTick(carriles[0], T)) return true;
+        carriles[0].ind = nullptr;
+        evaluaciones++;
+        return false;
+    }
+
+    /*
+     * avanzarEstado
+     * - Recibe: individuo, número de ticks a simular, estado donde escribir el resultado
+     * Simula los primeros ticks del plan desde el estado inicial del motor y
+     * guarda las posiciones y urgencias alcanzadas (las bases se copian del
+     * individuo). Sobrescribe el fitness del individuo con el de ese prefijo.
+     * - Retorna: true si el prefijo es válido (si no, el estado queda en el tick del fallo)
+     */
+    bool avanzarEstado(Individuo& ind, int ticks, EstadoSimulacion& estado) {
+        int controles = presupuesto_controles;
+        presupuesto_controles = 0;
+        Carril& c = carriles[0];
+        iniciarCarril(c, {&ind, nullptr, 0}, ticks);
+        while (avanzarTick(c, ticks)) {}
+        c.ind = nullptr;
+        presupuesto_controles = controles;
+        evaluaciones++;
+        
+        int k = ind.base_ids.size();
+        estado.base_ids = ind.base_ids;
+        estado.posiciones.resize(k);
+        for (int d = 0; d < k; d++) {
+            estado.posiciones[d] = {c.fila_dron[d], c.col_dron[d]};
+        }
+        estado.urgencia = c.urgencia;
+        return ind.es_valido;
+    }
+
+    /*
+     * usarKernel
+     * - Recibe: kernel de urgencias a usar en este motor
+     * - Retorna: void
+     */
+    void usarKernel(KernelUrgencia k) {
+        kernel = k;
+    }
+
+    /*
+     * usarEvaluacionPerezosa
+     * - Recibe: true para acumular urgencias en forma cerrada al visitar cada
+     *   celda, false para recorrerlas todas en cada tick con el kernel
+     * - Retorna: void
+     */
+    void usarEvaluacionPerezosa(bool activar) {
+        perezoso = activar;
+    }
+
+    /*
+     * evaluacionPerezosa
+     * - Recibe: nada
+     * - Retorna: true si el motor usa el evaluador perezoso
+     */
+    bool evaluacionPerezosa() const {
+        return perezoso;
+    }
+
+    /*
+     * presupuestoControles
+     * - Recibe: nada
+     * - Retorna: máximo de puntos de control por individuo (0 = desactivados)
+     */
+    int presupuestoControles() const {
+        return presupuesto_controles;
+    }
+
+    /*
+     * intervaloControles
+     * - Recibe: horizonte temporal T
+     * Reparte el presupuesto de puntos de control uniformemente en el horizonte.
+     * - Retorna: ticks entre puntos de control (0 si están desactivados)
+     */
+    int intervaloControles(int T) const {
+        if (presupuesto_controles == 0 || T < 2) return 0;
+        return max(1, (T + presupuesto_controles) / (presupuesto_controles + 1));
+    }
+
+    /*
+     * evaluacionesRealizadas
+     * - Recibe: nada
+     * - Retorna: número de individuos evaluados por este motor
+     */
+    long evaluacionesRealizadas() const {
+        return evaluaciones;
+    }
+
+    /*
+     * ticksSimulados
+     * - Recibe: nada
+     * - Retorna: ticks simulados por este motor (sumando todos los individuos)
+     */
+    long ticksSimulados() const {
+        return ticks_simulados;
+    }
+
+private:
+    /*
+     * Carril
+     * Estado de la simulación de un individuo dentro de un lote.
+     */
+    struct Carril {
+        Individuo* ind = nullptr;
+        vector<double> urgencia;       // urgencia actual de cada celda urgente
+        vector<int> ultimo;            // modo perezoso: tick al inicio del cual urgencia[u] es exacta
+        vector<int> fila_dron;
+        vector<int> col_dron;
+        double acumulado = 0.0;        // urgencia acumulada hasta el tick t
+        int t = 0;                     // próximo tick a simular
+    };
+
+    const Instancia& inst;
+    vector<Carril> carriles;
+    vector<uint64_t> ocupacion;        // mapa de bits de celdas ocupadas en el tick actual
+    vector<int> nueva_fila;            // posiciones destino de todos los drones en el tick
+    vector<int> nueva_col;
+    vector<int> celda_nueva;
+    vector<int> urgencias_visitadas;   // lista de dispersión para el reseteo
+    KernelUrgencia kernel;
+    bool perezoso;                     // acumular urgencias en forma cerrada (ver cerrarUrgencias)
+    int presupuesto_controles;         // máximo de puntos de control por individuo
+    const EstadoSimulacion* estado_inicial;    // nullptr = empezar en las bases
+    double urgencia_inicial_total;     // suma de las urgencias del estado inicial
+    double tasas_total;                // suma de las tasas de las celdas urgentes
+    long evaluaciones;
+    long ticks_simulados;
+
+    /*
+     * iniciarCarril
+     * - Recibe: carril, tarea a cargar, horizonte T
+     * Carga el estado inicial: desde el último punto de control usable del padre
+     * (copiando al hijo los puntos compartidos) o, si no hay, desde las bases.
+     * - Retorna: void
+     */
+    void iniciarCarril(Carril& c, const TareaEvaluacion& tarea, int T) {
+        Individuo& ind = *tarea.ind;
+        int k = ind.base_ids.size();
+        int num_urgencias = c.urgencia.size();
+        prepararDrones(c, k);
+        prepararControles(ind, k, T);
+        c.ind = &ind;
+        
+        int intervalo = ind.intervalo_control;
+        const Individuo* padre = tarea.padre;
+        int j = 0;
+        if (padre && intervalo > 0 && padre->intervalo_control == intervalo) {
+            j = min(tarea.tick_modificado / intervalo, padre->controles_validos);
+        }
+        
+        if (j == 0) {
+            if (estado_inicial) {
+                copy(estado_inicial->urgencia.begin(), estado_inicial->urgencia.end(), c.urgencia.begin());
+            } else {
+                fill(c.urgencia.begin(), c.urgencia.end(), 0.0);
+            }
+            for (int d = 0; d < k; d++) {
+                const Coordenada& pos_inicial = estado_inicial ? estado_inicial->posiciones[d]
+                                                               : inst.bases[ind.base_ids[d]];
+                c.fila_dron[d] = pos_inicial.fila;
+                c.col_dron[d] = pos_inicial.col;
+            }
+            c.acumulado = 0.0;
+            c.t = 0;
+            if (perezoso) fill(c.ultimo.begin(), c.ultimo.end(), 0);
+            return;
+        }
+        
+        // Copiar los puntos de control compartidos 1..j y restaurar el estado del j-ésimo
+        copy(padre->control_posiciones.begin(), padre->control_posiciones.begin() + j * 2 * k,
+             ind.control_posiciones.begin());
+        copy(padre->control_urgencias.begin(),
+             padre->control_urgencias.begin() + static_cast<size_t>(j) * num_urgencias,
+             ind.control_urgencias.begin());
+        copy(padre->control_acumulado.begin(), padre->control_acumulado.begin() + j,
+             ind.control_acumulado.begin());
+        ind.controles_validos = j;
+        
+        const int* pos = padre->control_posiciones.data() + (j - 1) * 2 * k;
+        for (int d = 0; d < k; d++) {
+            c.fila_dron[d] = pos[2 * d];
+            c.col_dron[d] = pos[2 * d + 1];
+        }
+        copy(padre->control_urgencias.begin() + static_cast<size_t>(j - 1) * num_urgencias,
+             padre->control_urgencias.begin() + static_cast<size_t>(j) * num_urgencias,
+             c.urgencia.begin());
+        c.acumulado = padre->control_acumulado[j - 1];
+        c.t = j * intervalo;
+        if (perezoso) fill(c.ultimo.begin(), c.ultimo.end(), c.t);
+    }
+
+    /*
+     * avanzarTick
+     * - Recibe: carril, horizonte T
+     * Simula el tick c.t del individuo del carril. Guarda un punto de control al
+     * inicio de cada intervalo. Al terminar el horizonte o encontrar un
+     * movimiento inválido escribe fitness y es_valido.
+     * - Retorna: true si el individuo sigue en simulación, false si terminó
+     */
+    bool avanzarTick(Carril& c, int T) {
+        Individuo& ind = *c.ind;
+        int t = c.t;
+        if (t >= T) {
+            if (perezoso) cerrarUrgencias(c, T);
+            ind.fitness = c.acumulado;
+            ind.es_valido = true;
+            return false;
+        }
+        
+        int k = ind.base_ids.size();
+        int num_urgencias = c.urgencia.size();
+        int intervalo = ind.intervalo_control;
+        ticks_simulados++;
+        
+        // 0. Guardar punto de control del estado al inicio del tick
+        if (intervalo > 0 && t > 0 && t % intervalo == 0 &&
+            t / intervalo <= static_cast<int>(ind.control_acumulado.size())) {
+            if (perezoso) cerrarUrgencias(c, t);
+            guardarControl(c, t / intervalo, k);
+        }
+        
+        // 1-2. Acumular urgencia antes de incrementar e incrementar todas las celdas
+        // (en modo perezoso se difiere hasta la visita o el cierre del horizonte)
+        if (!perezoso) {
+            c.acumulado += kernel(c.urgencia.data(), inst.tasas_densas.data(), num_urgencias);
+        }
+        
+        // Lista de urgencias vigiladas (posiciones al inicio del tick; puede repetir)
+        int num_visitadas = 0;
+        for (int d = 0; d < k; d++) {
+            if (!inst.dentroDeGrilla(c.fila_dron[d], c.col_dron[d])) continue;
+            int u = inst.indice_urgencia[inst.indiceCelda(c.fila_dron[d], c.col_dron[d])];
+            if (u >= 0) {
+                urgencias_visitadas[num_visitadas++] = u;
+            }
+        }
+        
+        // 3. Mover y validar (colisión permitida solo en bases)
+        if (!moverDrones(c, k, t)) {
+            if (perezoso) cerrarUrgencias(c, t + 1);
+            double penalizacion_base = 10000000.0; // 10 Millones
+            if (estado_inicial) {
+                // Con urgencias heredadas un plan válido puede superar los 10 millones:
+                // sumar la cota T·Σu0 + T(T+1)/2·Σtasas de su fitness para que ningún
+                // plan inválido le gane a uno válido
+                penalizacion_base += T * urgencia_inicial_total + 0.5 * T * (T + 1.0) * tasas_total;
+            }
+            double penalizacion_tiempo = (T - t) * 10000.0;
+            ind.fitness = c.acumulado + penalizacion_base + penalizacion_tiempo;
+            ind.es_valido = false;
+            return false;
+        }
+        
+        // 4. Resetear urgencias vigiladas (anula también el incremento del paso 2)
+        if (perezoso) {
+            const double* tasas = inst.tasas_densas.data();
+            for (int i = 0; i < num_visitadas; i++) {
+                // Aporte de los ticks ultimo..t: n·u + tasa·n(n-1)/2 (0 si ya se
+                // reseteó en este tick por otro dron en la misma celda)
+                int u = urgencias_visitadas[i];
+                double n = t + 1 - c.ultimo[u];
+                c.acumulado += n * c.urgencia[u] + tasas[u] * (0.5 * n * (n - 1.0));
+                c.urgencia[u] = 0.0;
+                c.ultimo[u] = t + 1;
+            }
+        } else {
+            for (int i = 0; i < num_visitadas; i++) {
+                c.urgencia[urgencias_visitadas[i]] = 0.0;
+            }
+        }
+        c.t = t + 1;
+        return true;
+    }
+
+    /*
+     * cerrarUrgencias
+     * - Recibe: carril en modo perezoso, tick t
+     * Suma al acumulado lo que cada celda aportó desde su último reseteo hasta
+     * el tick t-1 y deja en urgencia su valor al inicio del tick t, igual que
+     * en el modo denso (para cerrar el horizonte, penalizar un plan inválido o
+     * guardar un punto de control).
+     * - Retorna: void
+     */
+    void cerrarUrgencias(Carril& c, int t) {
+        const double* tasas = inst.tasas_densas.data();
+        int num_urgencias = c.urgencia.size();
+        for (int u = 0; u < num_urgencias; u++) {
+            double n = t - c.ultimo[u];
+            c.acumulado += n * c.urgencia[u] + tasas[u] * (0.5 * n * (n - 1.0));
+            c.urgencia[u] += n * tasas[u];
+            c.ultimo[u] = t;
+        }
+    }
+
+    /*
+     * moverDrones
+     * - Recibe: carril, número de drones k, tick t
+     * Calcula en bloque las k posiciones destino con la tabla de desplazamientos
+     * y las valida con operaciones sin saltos sobre arreglos contiguos (límites)
+     * y con mapas de bits (obstáculos, bases y ocupación del tick). Basta saber
+     * si algún dron es inválido: el fitness resultante no depende de cuál.
+     * - Retorna: true si todos los movimientos son válidos (y los aplica)
+     */
+    bool moverDrones(Carril& c, int k, int t) {
+        const uint8_t* acciones = c.ind->acciones.data() + t;
+        int paso = c.ind->ticks;
+        int* nf = nueva_fila.data();
+        int* nc = nueva_col.data();
+        
+        // Posiciones destino y verificación de límites (vectorizable)
+        unsigned fuera = 0;
+        for (int d = 0; d < k; d++) {
+            int accion = acciones[static_cast<size_t>(d) * paso];
+            nf[d] = c.fila_dron[d] + DELTA_FILA[accion];
+            nc[d] = c.col_dron[d] + DELTA_COL[accion];
+            fuera |= (static_cast<unsigned>(nf[d]) >= static_cast<unsigned>(inst.filas)) |
+                     (static_cast<unsigned>(nc[d]) >= static_cast<unsigned>(inst.columnas));
+        }
+        if (fuera) return false;
+        
+        // Obstáculos y colisiones fuera de bases con mapas de bits
+        const uint64_t* obstaculo = inst.bits_obstaculo.data();
+        const uint64_t* base = inst.bits_base.data();
+        uint64_t* ocupada = ocupacion.data();
+        uint64_t invalido = 0;
+        for (int d = 0; d < k; d++) {
+            int celda = nf[d] * inst.columnas + nc[d];
+            int palabra = celda >> 6;
+            uint64_t bit = uint64_t(1) << (celda & 63);
+            invalido |= obstaculo[palabra] & bit;
+            invalido |= ocupada[palabra] & ~base[palabra] & bit;
+            ocupada[palabra] |= bit;
+            celda_nueva[d] = celda;
+        }
+        
+        // Limpiar solo las palabras tocadas en este tick (no hay otros bits activos)
+        for (int d = 0; d < k; d++) {
+            ocupada[celda_nueva[d] >> 6] = 0;
+        }
+        if (invalido) return false;
+        
+        copy(nf, nf + k, c.fila_dron.begin());
+        copy(nc, nc + k, c.col_dron.begin());
+        return true;
+    }
+
+    /*
+     * prepararDrones
+     * - Recibe: carril, número de drones k
+     * Ajusta los buffers por dron; solo reserva memoria si k crece.
+     * - Retorna: void
+     */
+    void prepararDrones(Carril& c, int k) {
+        if (static_cast<int>(c.fila_dron.size()) < k) {
+            c.fila_dron.resize(k);
+            c.col_dron.resize(k);
+        }
+        if (static_cast<int>(nueva_fila.size()) < k) {
+            nueva_fila.resize(k);
+            nueva_col.resize(k);
+            celda_nueva.resize(k);
+            urgencias_visitadas.resize(k);
+        }
+    }
+
+    /*
+     * prepararControles
+     * - Recibe: individuo, número de drones k, horizonte T
+     * Dimensiona el almacenamiento de puntos de control del individuo y lo vacía.
+     * - Retorna: void
+     */
+    void prepararControles(Individuo& ind, int k, int T) {
+        int intervalo = intervaloControles(T);
+        int n = (intervalo == 0) ? 0 : min(presupuesto_controles, (T - 1) / intervalo);
+        ind.intervalo_control = intervalo;
+        ind.controles_validos = 0;
+        ind.control_posiciones.resize(static_cast<size_t>(n) * 2 * k);
+        ind.control_urgencias.resize(static_cast<size_t>(n) * inst.tasas_densas.size());
+        ind.control_acumulado.resize(n);
+    }
+
+    /*
+     * guardarControl
+     * - Recibe: carril, número de punto j (1-based), k
+     * Copia el estado actual del carril en el punto de control j de su individuo.
+     * - Retorna: void
+     */
+    void guardarControl(Carril& c, int j, int k) {
+        Individuo& ind = *c.ind;
+        int* pos = ind.control_posiciones.data() + (j - 1) * 2 * k;
+        for (int d = 0; d < k; d++) {
+            pos[2 * d] = c.fila_dron[d];
+            pos[2 * d + 1] = c.col_dron[d];
+        }
+        copy(c.urgencia.begin(), c.urgencia.end(),
+             ind.control_urgencias.begin() + static_cast<size_t>(j - 1) * c.urgencia.size());
+        ind.control_acumulado[j - 1] = c.acumulado;
+        ind.controles_validos = j;
+    }
+};
+
+/*
+ * calcularFitness
+ * - Recibe: individuo a evaluar, motor de evaluación, horizonte temporal T
+ * Simula el plan de vuelo y calcula la urgencia acumulada total.
+ * Aplica penalización gradual para soluciones inválidas (mejor que penalización fija).
+ * - Retorna: void (modifica fitness y es_valido del individuo)
+ */
+void calcularFitness(Individuo& ind, MotorEvaluacion& motor, int T) {
+    motor.evaluar(ind, T);
+}
+
+/*
+ * primerTickModificado
+ * - Recibe: hijo y padre con las mismas bases, horizonte T
+ * Busca el primer tick en que alguna acción del hijo difiere de la del padre.
+ * - Retorna: tick encontrado (T si los planes son iguales)
+ */
+int primerTickModificado(const Individuo& hijo, const Individuo& padre, int T) {
+    int primero = T;
+    for (size_t d = 0; d < hijo.base_ids.size(); ++d) {
+        const uint8_t* a = hijo.plan(d);
+        const uint8_t* b = padre.plan(d);
+        primero = mismatch(a, a + primero, b).first - a;
+    }
+    return primero;
+}
+
+/*
+ * hashPlan
+ * - Recibe: individuo
+ * Mezcla k, T, las bases y las acciones (de a 8 bytes) en un hash de 64 bits.
+ * - Retorna: hash del cromosoma (nunca 0, que marca entradas vacías de CacheFitness)
+ */
+uint64_t hashPlan(const Individuo& ind) {
+    auto mezclar = [](uint64_t h, uint64_t v) {
+        h = (h ^ v) * 0x9E3779B97F4A7C15ULL;
+        return h ^ (h >> 29);
+    };
+    uint64_t h = mezclar(0x243F6A8885A308D3ULL, (static_cast<uint64_t>(ind.base_ids.size()) << 32) | ind.ticks);
+    for (int b : ind.base_ids) h = mezclar(h, static_cast<uint32_t>(b));
+    const uint8_t* datos = ind.acciones.data();
+    size_t n = ind.acciones.size();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint64_t palabra;
+        memcpy(&palabra, datos + i, 8);
+        h = mezclar(h, palabra);
+    }
+    uint64_t resto = 0;
+    if (n > i) memcpy(&resto, datos + i, n - i);
+    h = mezclar(h, resto ^ (static_cast<uint64_t>(n - i) << 56));
+    return h ? h : 1;
+}
+
+/*
+ * CacheFitness
+ * Tabla acotada de asignación directa hash del cromosoma -> (fitness, validez).
+ * Cada hash ocupa la entrada hash & (capacidad - 1) y reemplaza a la anterior.
+ * Solo se guarda el hash de 64 bits, no el cromosoma: una colisión devolvería
+ * el fitness de otro plan, con probabilidad ~2^-64 por consulta.
+ * No usa bloqueos: el AE consulta en paralelo durante la generación (solo
+ * lectura) e inserta desde un solo hilo después, así que el contenido y los
+ * aciertos no dependen de la temporización de los hilos.
+ */
+class CacheFitness {
+public:
+    /*
+     * Constructor
+     * - Recibe: número de entradas (se redondea a la potencia de 2 siguiente)
+     */
+    explicit CacheFitness(size_t entradas) {
+        size_t capacidad = 1;
+        while (capacidad < entradas) capacidad <<= 1;
+        tabla.assign(capacidad, Entrada{0, 0.0, false});
+        mascara = capacidad - 1;
+    }
+
+    /*
+     * buscar
+     * - Recibe: hash del cromosoma, individuo donde escribir el resultado
+     * - Retorna: true si el hash estaba en la tabla (copia fitness y es_valido)
+     */
+    bool buscar(uint64_t clave, Individuo& ind) const {
+        const Entrada& e = tabla[clave & mascara];
+        if (e.clave != clave) return false;
+        ind.fitness = e.fitness;
+        ind.es_valido = e.valido;
+        return true;
+    }
+
+    /*
+     * insertar
+     * - Recibe: hash del cromosoma, individuo ya evaluado
+     * - Retorna: void (sobrescribe la entrada que corresponde al hash)
+     */
+    void insertar(uint64_t clave, const Individuo& ind) {
+        tabla[clave & mascara] = Entrada{clave, ind.fitness, ind.es_valido};
+    }
+
+    /*
+     * capacidad
+     * - Recibe: nada
+     * - Retorna: número de entradas de la tabla
+     */
+    size_t capacidad() const {
+        return tabla.size();
+    }
+
+private:
+    struct Entrada {
+        uint64_t clave;     // 0 = vacía
+        double fitness;
+        bool valido;
+    };
+    vector<Entrada> tabla;
+    size_t mascara;
+};
+
+/*
+ * PoolHilos
+ * Conjunto persistente de hilos trabajadores.
+ * Se usa para repartir una tarea entre n trabajadores (el hilo llamador actúa
+ * como trabajador 0) sin crear hilos nuevos en cada generación.
+ */
+class PoolHilos {
+public:
+    explicit PoolHilos(int num_hilos)
+        : num_trabajadores(num_hilos), tarea(nullptr), ronda(0), pendientes(0), terminar(false) {
+        for (int w = 1; w < num_trabajadores; ++w) {
+            hilos.emplace_back([this, w]() { bucleTrabajador(w); });
+        }
+    }
+
+    ~PoolHilos() {
+        {
+            lock_guard<mutex> lock(mtx);
+            terminar = true;
+        }
+        cv_inicio.notify_all();
+        for (thread& h : hilos) h.join();
+    }
+
+    /*
+     * ejecutar
+     * - Recibe: tarea a ejecutar con el índice del trabajador (0..n-1)
+     * Ejecuta la tarea en todos los trabajadores y espera a que terminen.
+     * - Retorna: void
+     */
+    void ejecutar(const function<void(int)>& t) {
+        {
+            lock_guard<mutex> lock(mtx);
+            tarea = &t;
+            pendientes = num_trabajadores - 1;
+            ronda++;
+        }
+        cv_inicio.notify_all();
+        t(0);
+        unique_lock<mutex> lock(mtx);
+        cv_fin.wait(lock, [this]() { return pendientes == 0; });
+        tarea = nullptr;
+    }
+
+    int tamano() const { return num_trabajadores; }
+
+private:
+    int num_trabajadores;
+    vector<thread> hilos;
+    mutex mtx;
+    condition_variable cv_inicio;
+    condition_variable cv_fin;
+    const function<void(int)>* tarea;
+    long ronda;
+    int pendientes;
+    bool terminar;
+
+    void bucleTrabajador(int w) {
+        long ronda_vista = 0;
+        while (true) {
+            const function<void(int)>* t;
+            {
+                unique_lock<mutex> lock(mtx);
+                cv_inicio.wait(lock, [&]() { return terminar || ronda != ronda_vista; });
+                if (terminar) return;
+                ronda_vista = ronda;
+                t = tarea;
+            }
+            (*t)(w);
+            {
+                lock_guard<mutex> lock(mtx);
+                pendientes--;
+            }
+            cv_fin.notify_one();
+        }
+    }
+};
+
+/*
+ * accionValidaAleatoria
+ * - Recibe: instancia, posición actual del dron, generador
+ * Elige al azar una de las acciones de la máscara precalculada de la celda,
+ * que no sacan al dron de la grilla ni lo llevan a un obstáculo (si el dron
+ * ya está fuera de la grilla devuelve "permanecer"; la reparación lo corrige).
+ * - Retorna: código de acción válida (0-8)
+ */
+int accionValidaAleatoria(const Instancia& inst, const Coordenada& pos, GeneradorRng& gen) {
+    if (!inst.dentroDeGrilla(pos.fila, pos.col)) return 0;
+    unsigned mascara = inst.movimientos_validos[inst.indiceCelda(pos.fila, pos.col)];
+    if (mascara == 0) return 0;
+    uniform_int_distribution<int> dist(0, __builtin_popcount(mascara) - 1);
+    for (int r = dist(gen); r > 0; --r) {
+        mascara &= mascara - 1;  // descartar las acciones anteriores a la elegida
+    }
+    return __builtin_ctz(mascara);
+}
+
+/*
+ * OperadorMutacion
+ * Operador que AlgoritmoEvolutivo::mutar aplica a cada gen (dron d, tick t)
+ * elegido por el muestreo geométrico. Recibe la posición del dron al inicio
+ * del tick t según el plan actual y puede modificar cualquier acción del dron;
+ * la reparación posterior corrige los movimientos que queden inválidos.
+ */
+typedef void (*OperadorMutacion)(const Instancia& inst, Individuo& ind, int d, int t,
+                                 const Coordenada& pos, GeneradorRng& gen);
+
+// Ticks máximos que reescribe la mutación de segmento
+const int LARGO_SEGMENTO_MUTACION = 8;
+
+/*
+ * mutacionPuntual
+ * - Recibe: ver OperadorMutacion
+ * Reemplaza la acción del gen por una acción válida al azar desde la celda actual.
+ * - Retorna: void
+ */
+void mutacionPuntual(const Instancia& inst, Individuo& ind, int d, int t,
+                     const Coordenada& pos, GeneradorRng& gen) {
+    ind.accion(d, t) = accionValidaAleatoria(inst, pos, gen);
+}
+
+/*
+ * mutacionIntercambio
+ * - Recibe: ver OperadorMutacion
+ * Intercambia la acción del gen con la de un tick posterior al azar del mismo
+ * dron. La suma de desplazamientos no cambia, así que después de ambos ticks
+ * el dron vuelve a la celda que tenía en el plan original.
+ * - Retorna: void
+ */
+void mutacionIntercambio(const Instancia&, Individuo& ind, int d, int t,
+                         const Coordenada&, GeneradorRng& gen) {
+    uniform_int_distribution<int> dist_tick(t, ind.ticks - 1);
+    swap(ind.accion(d, t), ind.accion(d, dist_tick(gen)));
+}
+
+/*
+ * mutacionSegmento
+ * - Recibe: ver OperadorMutacion
+ * Reescribe desde el gen un tramo de 2 a LARGO_SEGMENTO_MUTACION ticks con
+ * una caminata aleatoria de acciones válidas.
+ * - Retorna: void
+ */
+void mutacionSegmento(const Instancia& inst, Individuo& ind, int d, int t,
+                      const Coordenada& pos, GeneradorRng& gen) {
+    uniform_int_distribution<int> dist_largo(2, LARGO_SEGMENTO_MUTACION);
+    int fin = min(ind.ticks, t + dist_largo(gen));
+    Coordenada actual = pos;
+    for (int s = t; s < fin; ++s) {
+        int accion = accionValidaAleatoria(inst, actual, gen);
+        ind.accion(d, s) = accion;
+        actual.fila += DELTA_FILA[accion];
+        actual.col += DELTA_COL[accion];
+    }
+}
+
+/*
+ * mutacionUrgencia
+ * - Recibe: ver OperadorMutacion
+ * Mueve al dron hacia la urgencia más cercana: entre las acciones válidas que
+ * no son "permanecer" elige la de menor distancia (BFS precalculada) a una
+ * celda urgente, desempatando al azar.
+ * - Retorna: void
+ */
+void mutacionUrgencia(const Instancia& inst, Individuo& ind, int d, int t,
+                      const Coordenada& pos, GeneradorRng& gen) {
+    if (!inst.dentroDeGrilla(pos.fila, pos.col)) {
+        ind.accion(d, t) = 0;
+        return;
+    }
+    int celda = inst.indiceCelda(pos.fila, pos.col);
+    unsigned mascara = inst.movimientos_validos[celda] & ~1u;
+    int mejor = 0;
+    int mejor_distancia = numeric_limits<int>::max();
+    int empates = 0;
+    for (; mascara; mascara &= mascara - 1) {
+        int accion = __builtin_ctz(mascara);
+        int distancia = inst.distancia_urgencia[celda + DELTA_FILA[accion] * inst.columnas + DELTA_COL[accion]];
+        if (distancia < 0) distancia = numeric_limits<int>::max() - 1;
+        if (distancia < mejor_distancia) {
+            mejor = accion;
+            mejor_distancia = distancia;
+            empates = 1;
+        } else if (distancia == mejor_distancia &&
+                   uniform_int_distribution<int>(0, empates++)(gen) == 0) {
+            mejor = accion;
+        }
+    }
+    ind.accion(d, t) = mejor;
+}
+
+// Operadores de mutación disponibles por nombre (--operadores)
+const struct {
+    const char* nombre;
+    OperadorMutacion operador;
+} OPERADORES_MUTACION[] = {
+    {"puntual", mutacionPuntual},
+    {"intercambio", mutacionIntercambio},
+    {"segmento", mutacionSegmento},
+    {"urgencia", mutacionUrgencia},
+};
+
+/*
+ * operadorMutacionPorNombre
+ * - Recibe: nombre del operador
+ * - Retorna: operador correspondiente (nullptr si no existe)
+ */
+OperadorMutacion operadorMutacionPorNombre(const string& nombre) {
+    for (const auto& op : OPERADORES_MUTACION) {
+        if (nombre == op.nombre) return op.operador;
+    }
+    return nullptr;
+}
+
+// Fases del algoritmo evolutivo medidas por separado cuando medir_tiempos está activo
+enum FaseAE {
+    FASE_INICIALIZACION,
+    FASE_SELECCION,
+    FASE_CRUCE,
+    FASE_MUTACION,
+    FASE_REPARACION,
+    FASE_EVALUACION,
+    FASE_BUSQUEDA_LOCAL,
+    FASE_FUSIONADA,
+    NUM_FASES
+};
+
+const char* const NOMBRES_FASES[NUM_FASES] = {
+    "inicializacion", "seleccion", "cruce", "mutacion", "reparacion", "evaluacion", "busqueda_local",
+    "fusionada"
+};
+
+// Vecinos evaluados en lote por cada paso de la búsqueda local (= acciones alternativas de un gen)
+const int VECINOS_BUSQUEDA = 8;
+
+// Puntos de control por individuo usados por la búsqueda local
+const int CONTROLES_BUSQUEDA_LOCAL = 16;
+
+/*
+ * RegistroGeneracion
+ * Resumen de una generación de una población para la traza de convergencia.
+ */
+struct RegistroGeneracion {
+    int isla;                           // 0 sin modelo de islas
+    int generacion;                     // 0 = población inicial
+    double tiempo_s;                    // segundos desde que se abrió la traza
+    long evaluaciones;                  // evaluaciones realizadas en esta generación
+    double mejor;
+    double media;
+    double peor;
+    double fraccion_validos;
+    array<double, NUM_FASES> tiempo_fase_ms;    // tiempo de cada fase en esta generación
+};
+
+/*
+ * TrazaConvergencia
+ * Traza por generación escrita en CSV o en JSON (según la extensión del archivo).
+ * Cada población registra en su propio buffer preasignado de capacidad fija,
+ * así que registrar una generación solo copia un RegistroGeneracion, sin
+ * bloqueos ni reservas de memoria. Cuando un buffer se llena se vuelca al
+ * archivo (el único momento en que se toma el mutex) y al cerrar se vuelca lo
+ * pendiente, de modo que la traza se escribe de a bloques durante la ejecución.
+ */
+class TrazaConvergencia {
+public:
+    /*
+     * Constructor
+     * - Recibe: ruta del archivo, número de poblaciones que registran (islas),
+     *   registros que caben en el buffer de cada una
+     */
+    TrazaConvergencia(const string& ruta, int poblaciones, size_t capacidad)
+        : archivo(ruta), json(ruta.size() >= 5 && ruta.compare(ruta.size() - 5, 5, ".json") == 0),
+          buffers(poblaciones, vector<RegistroGeneracion>(max<size_t>(1, capacidad))),
+          usados(poblaciones, 0), escritos(0), inicio(chrono::steady_clock::now()) {
+        if (!archivo) {
+            throw runtime_error("no se pudo crear la traza " + ruta);
+        }
+        if (json) {
+            archivo << "[";
+        } else {
+            archivo << "isla,generacion,tiempo_s,evaluaciones,mejor,media,peor,fraccion_validos";
+            for (int f = 0; f < NUM_FASES; ++f) archivo << "," << NOMBRES_FASES[f] << "_ms";
+            archivo << "\n";
+        }
+    }
+
+    ~TrazaConvergencia() {
+        cerrar();
+    }
+
+    /*
+     * registrar
+     * - Recibe: registro de una generación (solo lo llama el hilo de r.isla)
+     * - Retorna: void (vuelca el buffer de la población si estaba lleno)
+     */
+    void registrar(const RegistroGeneracion& r) {
+        if (usados[r.isla] == buffers[r.isla].size()) vaciar(r.isla);
+        buffers[r.isla][usados[r.isla]++] = r;
+    }
+
+    /*
+     * segundos
+     * - Recibe: nada
+     * - Retorna: segundos transcurridos desde que se abrió la traza
+     */
+    double segundos() const {
+        return chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    }
+
+    /*
+     * cerrar
+     * - Recibe: nada
+     * Vuelca los registros pendientes de todas las poblaciones y cierra el archivo.
+     * - Retorna: número total de generaciones escritas
+     */
+    long cerrar() {
+        if (archivo.is_open()) {
+            for (size_t p = 0; p < buffers.size(); ++p) vaciar(p);
+            if (json) archivo << "\n]\n";
+            archivo.close();
+        }
+        return escritos;
+    }
+
+private:
+    ofstream archivo;
+    bool json;
+    vector<vector<RegistroGeneracion>> buffers;
+    vector<size_t> usados;
+    long escritos;
+    mutex mtx;
+    chrono::steady_clock::time_point inicio;
+
+    /*
+     * vaciar
+     * - Recibe: índice de la población
+     * Escribe los registros del buffer de la población y lo deja vacío.
+     * - Retorna: void
+     */
+    void vaciar(int p) {
+        lock_guard<mutex> lock(mtx);
+        for (size_t i = 0; i < usados[p]; ++i) {
+            const RegistroGeneracion& r = buffers[p][i];
+            archivo << defaultfloat << setprecision(6);
+            if (json) {
+                archivo << (escritos > 0 ? ",\n" : "\n")
+                        << "{\"isla\": " << r.isla << ", \"generacion\": " << r.generacion
+                        << ", \"tiempo_s\": " << r.tiempo_s << ", \"evaluaciones\": " << r.evaluaciones
+                        << fixed << setprecision(2) << ", \"mejor\": " << r.mejor
+                        << ", \"media\": " << r.media << ", \"peor\": " << r.peor
+                        << setprecision(4) << ", \"fraccion_validos\": " << r.fraccion_validos
+                        << setprecision(3);
+                for (int f = 0; f < NUM_FASES; ++f) {
+                    archivo << ", \"" << NOMBRES_FASES[f] << "_ms\": " << r.tiempo_fase_ms[f];
+                }
+                archivo << "}";
+            } else {
+                archivo << r.isla << "," << r.generacion << "," << r.tiempo_s << "," << r.evaluaciones
+                        << fixed << setprecision(2) << "," << r.mejor << "," << r.media << "," << r.peor
+                        << setprecision(4) << "," << r.fraccion_validos << setprecision(3);
+                for (int f = 0; f < NUM_FASES; ++f) archivo << "," << r.tiempo_fase_ms[f];
+                archivo << "\n";
+            }
+            escritos++;
+        }
+        usados[p] = 0;
+    }
+};
+
+// Formato binario de checkpoints del AE: firma, versión y cabecera de tamaño fijo
+const char FIRMA_CHECKPOINT[8] = {'P', 'S', 'P', 'C', 'K', 'P', 'T', '\0'};
+const uint32_t VERSION_CHECKPOINT = 3;
+
+/*
+ * EstadoParada
+ * Estado de ControlParada guardado en un checkpoint, para que una ejecución
+ * reanudada cuente generaciones, evaluaciones, estancamiento y tiempo desde
+ * donde quedó.
+ */
+struct EstadoParada {
+    int64_t pasos;
+    int64_t ultimo_progreso;
+    int64_t evaluaciones;
+    double referencia;
+    double segundos;
+    int32_t hay_referencia;
+    int32_t reservado;
+};
+
+/*
+ * ConfiguracionCheckpoint
+ * Parámetros del AE que cambian la trayectoria de la búsqueda (o, la caché,
+ * el número de evaluaciones). Una ejecución reanudada debe repetirlos: lo
+ * comprueba restaurarEstado.
+ */
+struct ConfiguracionCheckpoint {
+    double tasa_mutacion;
+    int32_t elite;
+    int32_t torneo;
+    int32_t fusionado;
+    int32_t intervalo_memetico;     // 0 = sin búsqueda local (top y pasos quedan en 0)
+    int32_t top_memetico;
+    int32_t pasos_memetico;
+    int32_t max_controles;
+    int32_t evaluador_perezoso;
+    uint64_t huella_operadores;     // operadores de mutación, en orden, con sus pesos acumulados
+    uint64_t entradas_cache;        // capacidad de la caché de fitness (0 = sin caché)
+};
+static_assert(sizeof(ConfiguracionCheckpoint) == 56, "la configuración del checkpoint debe ocupar 56 bytes");
+
+/*
+ * CabeceraCheckpoint
+ * Cabecera de 160 bytes de un checkpoint. Le siguen, sin relleno: por cada
+ * generador, uint32_t largo y su estado (ver GeneradorRng::estado); y por
+ * cada individuo, int32_t base_ids[k], uint8_t acciones[k * T] (dron-mayor),
+ * double fitness y uint8_t es_valido. Cierra el archivo un PieCheckpoint.
+ */
+struct CabeceraCheckpoint {
+    char firma[8];
+    uint32_t version;
+    int32_t k;
+    int32_t T;
+    int32_t poblacion;
+    int32_t generadores;
+    int32_t tipo_rng;
+    uint32_t semilla;
+    int32_t generacion;
+    uint64_t huella_instancia;      // Instancia::huella de la instancia de la ejecución
+    int64_t evaluaciones;           // evaluaciones del AE hasta el checkpoint
+    EstadoParada parada;
+    ConfiguracionCheckpoint configuracion;
+};
+static_assert(sizeof(CabeceraCheckpoint) == 160, "la cabecera del checkpoint debe ocupar 160 bytes");
+
+/*
+ * PieCheckpoint
+ * Últimos 16 bytes de un checkpoint: largo y CRC-32 de todo lo anterior,
+ * para detectar archivos truncados o dañados antes de interpretarlos.
+ */
+struct PieCheckpoint {
+    uint64_t largo;
+    uint32_t crc;
+    uint32_t reservado;
+};
+static_assert(sizeof(PieCheckpoint) == 16, "el pie del checkpoint debe ocupar 16 bytes");
+
+/*
+ * crc32
+ * - Recibe: datos y cantidad de bytes
+ * CRC-32 estándar (polinomio reflejado 0xEDB88320) con tabla de 256 entradas.
+ * - Retorna: CRC de los datos
+ */
+uint32_t crc32(const char* datos, size_t n) {
+    static const array<uint32_t, 256> tabla = [] {
+        array<uint32_t, 256> t;
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int b = 0; b < 8; ++b) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < n; ++i) {
+        crc = tabla[(crc ^ static_cast<uint8_t>(datos[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+/*
+ * Checkpoint
+ * Contenido de un archivo de checkpoint ya leído.
+ */
+struct Checkpoint {
+    CabeceraCheckpoint cabecera;
+    vector<string> estados_rng;     // uno por trabajador
+    vector<Individuo> poblacion;
+};
+
+/*
+ * leerCheckpoint
+ * - Recibe: ruta del archivo
+ * Verifica el pie (largo y CRC-32) antes de interpretar el contenido y
+ * valida cada campo antes de reservar memoria con él: tamaños coherentes con
+ * el largo del archivo, tipo de generador conocido, bases no negativas y
+ * acciones entre 0 y 8. Que las bases existan en la instancia lo comprueba
+ * restaurarEstado (adaptarPlan las lleva al rango de la instancia).
+ * - Retorna: checkpoint leído (lanza runtime_error si no existe, no es un
+ *   checkpoint, es de otra versión, está truncado o dañado)
+ */
+Checkpoint leerCheckpoint(const string& ruta) {
+    ifstream archivo(ruta, ios::binary);
+    if (!archivo) {
+        throw runtime_error("no se pudo abrir el checkpoint " + ruta);
+    }
+    vector<char> datos((istreambuf_iterator<char>(archivo)), istreambuf_iterator<char>());
+    size_t pos = 0;
+    auto invalido = [&](const string& detalle) {
+        return runtime_error(ruta + ": checkpoint " + detalle);
+    };
+    auto leer = [&](void* destino, size_t n) {
+        if (datos.size() - pos < n) throw invalido("truncado");
+        memcpy(destino, datos.data() + pos, n);
+        pos += n;
+    };
+    
+    Checkpoint ck;
+    CabeceraCheckpoint& c = ck.cabecera;
+    leer(&c, sizeof(c));
+    if (memcmp(c.firma, FIRMA_CHECKPOINT, sizeof(c.firma)) != 0) {
+        throw runtime_error(ruta + " no es un checkpoint de PSP-UAV");
+    }
+    if (c.version != VERSION_CHECKPOINT) {
+        throw runtime_error(ruta + ": versión de checkpoint " + to_string(c.version) + " no soportada");
+    }
+    PieCheckpoint pie;
+    if (datos.size() < sizeof(c) + sizeof(pie)) throw invalido("truncado");
+    memcpy(&pie, datos.data() + datos.size() - sizeof(pie), sizeof(pie));
+    datos.resize(datos.size() - sizeof(pie));
+    if (pie.largo != datos.size()) throw invalido("truncado");
+    if (pie.crc != crc32(datos.data(), datos.size())) throw invalido("dañado (CRC distinto)");
+    
+    if (c.k <= 0 || c.T <= 0 || c.poblacion <= 0 || c.generadores <= 0 || c.generacion < 0 ||
+        (c.tipo_rng != RNG_MT19937 && c.tipo_rng != RNG_XOSHIRO)) {
+        throw invalido("con cabecera inválida");
+    }
+    // Cada generador ocupa al menos su largo y cada individuo un tamaño fijo:
+    // comprobarlo antes de reservar evita reservas gigantes con datos dañados
+    uint64_t por_individuo = static_cast<uint64_t>(c.k) * (sizeof(int32_t) + c.T) + sizeof(double) + 1;
+    uint64_t resto = datos.size() - pos;
+    if (static_cast<uint64_t>(c.generadores) > resto / sizeof(uint32_t) ||
+        static_cast<uint64_t>(c.poblacion) > resto / por_individuo) {
+        throw invalido("con tamaños inconsistentes con el archivo");
+    }
+    
+    ck.estados_rng.resize(c.generadores);
+    for (string& estado : ck.estados_rng) {
+        uint32_t largo;
+        leer(&largo, sizeof(largo));
+        if (largo > datos.size() - pos) throw invalido("truncado");
+        estado.assign(datos.data() + pos, largo);
+        pos += largo;
+    }
+    if (static_cast<uint64_t>(c.poblacion) * por_individuo != datos.size() - pos) {
+        throw invalido("con tamaños inconsistentes con el archivo");
+    }
+    ck.poblacion.resize(c.poblacion);
+    for (Individuo& ind : ck.poblacion) {
+        ind.redimensionar(c.k, c.T);
+        uint8_t valido;
+        leer(ind.base_ids.data(), c.k * sizeof(int32_t));
+        leer(ind.acciones.data(), ind.acciones.size());
+        leer(&ind.fitness, sizeof(double));
+        leer(&valido, 1);
+        ind.es_valido = valido != 0;
+        for (int base : ind.base_ids) {
+            if (base < 0) throw invalido("con una base negativa");
+        }
+        for (uint8_t accion : ind.acciones) {
+            if (accion >= 9) throw invalido("con una acción fuera de rango");
+        }
+        if (isnan(ind.fitness)) throw invalido("con un fitness inválido");
+    }
+    return ck;
+}
+
+/*
+ * EscritorCheckpoint
+ * Escribe checkpoints desde un hilo propio para no detener el ciclo
+ * evolutivo: el AE serializa su estado en un buffer (copias de memoria) y lo
+ * entrega con encolar; el hilo lo vuelca a <ruta>.tmp y lo renombra sobre la
+ * ruta, así que el archivo siempre contiene un checkpoint completo. Si llega
+ * uno nuevo mientras se escribe el anterior, solo se conserva el más reciente.
+ */
+class EscritorCheckpoint {
+public:
+    explicit EscritorCheckpoint(const string& ruta_archivo)
+        : ruta(ruta_archivo), hay_pendiente(false), escribiendo(false), terminar(false),
+          escritos(0), fallidos(0), hilo(&EscritorCheckpoint::ejecutar, this) {}
+
+    ~EscritorCheckpoint() {
+        {
+            lock_guard<mutex> bloqueo(mtx);
+            terminar = true;
+        }
+        cv_pendiente.notify_one();
+        hilo.join();
+    }
+
+    /*
+     * encolar
+     * - Recibe: buffer con un checkpoint serializado; a cambio queda con la
+     *   memoria de un buffer ya escrito, para reutilizarla en la próxima serialización
+     * - Retorna: void
+     */
+    void encolar(vector<char>& datos) {
+        {
+            lock_guard<mutex> bloqueo(mtx);
+            swap(pendiente, datos);
+            hay_pendiente = true;
+        }
+        cv_pendiente.notify_one();
+    }
+
+    /*
+     * esperar
+     * - Recibe: nada
+     * Bloquea hasta que el último checkpoint encolado esté en disco.
+     * - Retorna: número de checkpoints escritos y de escrituras fallidas
+     */
+    pair<long, long> esperar() {
+        unique_lock<mutex> bloqueo(mtx);
+        cv_libre.wait(bloqueo, [this] { return !hay_pendiente && !escribiendo; });
+        return {escritos, fallidos};
+    }
+
+private:
+    string ruta;
+    vector<char> pendiente;
+    bool hay_pendiente;
+    bool escribiendo;
+    bool terminar;
+    long escritos;
+    long fallidos;
+    mutex mtx;
+    condition_variable cv_pendiente;
+    condition_variable cv_libre;
+    thread hilo;                    // último miembro: arranca con el resto ya construido
+
+    void ejecutar() {
+        vector<char> datos;
+        unique_lock<mutex> bloqueo(mtx);
+        while (true) {
+            cv_pendiente.wait(bloqueo, [this] { return hay_pendiente || terminar; });
+            if (!hay_pendiente) break;
+            swap(datos, pendiente);
+            hay_pendiente = false;
+            escribiendo = true;
+            bloqueo.unlock();
+            bool ok = volcar(datos);
+            bloqueo.lock();
+            escribiendo = false;
+            if (ok) escritos++; else fallidos++;
+            cv_libre.notify_all();
+        }
+    }
+
+    /*
+     * volcar
+     * - Recibe: checkpoint serializado
+     * Lo escribe en <ruta>.tmp seguido de su PieCheckpoint (el CRC se calcula
+     * en este hilo, fuera del ciclo evolutivo), lo sincroniza con el disco y lo
+     * renombra sobre la ruta.
+     * - Retorna: true si se escribió completo
+     */
+    bool volcar(const vector<char>& datos) const {
+        PieCheckpoint pie = {datos.size(), crc32(datos.data(), datos.size()), 0};
+        string temporal = ruta + ".tmp";
+        FILE* archivo = fopen(temporal.c_str(), "wb");
+        if (!archivo) return false;
+        bool ok = fwrite(datos.data(), 1, datos.size(), archivo) == datos.size();
+        ok = fwrite(&pie, sizeof(pie), 1, archivo) == 1 && ok;
+        ok = fflush(archivo) == 0 && ok;
+        ok = fsync(fileno(archivo)) == 0 && ok;
+        ok = fclose(archivo) == 0 && ok;
+        return ok && rename(temporal.c_str(), ruta.c_str()) == 0;
+    }
+};
+
+/*
+ * AlgoritmoEvolutivo
+ * Gestiona la población de individuos y ejecuta el proceso evolutivo.
+ * Se usa para encontrar la mejor solución mediante selección, cruce y mutación.
+ */
+class AlgoritmoEvolutivo {
+public:
+    vector<Individuo> poblacion;
+    vector<Individuo> poblacion_siguiente;  // segundo buffer; se intercambia con poblacion
+    int tam_poblacion;
+    double tasa_mutacion;
+    int k_drones;
+    int T_ticks;
+    const Instancia& inst;
+    int num_hilos;
+    vector<GeneradorRng> generadores;   // un flujo aleatorio por trabajador
+    vector<MotorEvaluacion> motores;    // buffers de evaluación por trabajador
+    unique_ptr<PoolHilos> pool;
+    int num_elite;                      // individuos copiados sin cambios a la siguiente generación
+    int tam_torneo;                     // participantes de cada torneo de selección
+    int idx_mejor;                      // índice del mejor individuo de la población actual
+    vector<int> ranking;                // permutación de índices; los primeros num_elite son la élite
+    bool medir_tiempos;                 // acumular tiempo por fase (benchmark)
+    vector<array<double, NUM_FASES>> tiempos_fase_hilo;
+    vector<vector<TareaEvaluacion>> lotes_hilo; // hijos pendientes de evaluar por trabajador
+    int generacion;                     // generaciones ejecutadas
+    int intervalo_busqueda;             // generaciones entre etapas de búsqueda local (0 = desactivada)
+    int top_busqueda;                   // mejores individuos refinados en cada etapa
+    int pasos_busqueda;                 // pasos de búsqueda local por individuo
+    vector<MotorEvaluacion> motores_locales;    // motores con puntos de control, por trabajador
+    vector<vector<Individuo>> vecinos_hilo;     // buffers de vecinos por trabajador
+    vector<vector<int>> celdas_reparacion;      // celda actual de cada dron durante la reparación
+    vector<vector<uint64_t>> reservas_reparacion; // celdas reservadas en el tick (mapa de bits)
+    unique_ptr<CacheFitness> cache;     // fitness de cromosomas ya evaluados (nullptr = desactivada)
+    vector<uint64_t> claves_hijos;      // hash de cada individuo nuevo de la generación
+    vector<char> hijos_en_cache;        // 1 si el fitness del individuo salió de la caché
+    long consultas_cache;
+    long aciertos_cache;
+    TrazaConvergencia* traza;           // nullptr = sin traza de convergencia
+    int indice_traza;                   // población (isla) con la que se registra
+    long evaluaciones_traza;            // evaluaciones al registrar la generación anterior
+    array<double, NUM_FASES> fases_traza;   // tiempos de fase al registrar la generación anterior
+    const EstadoSimulacion* estado_inicial; // inicio de la ventana (nullptr = bases, urgencias en cero)
+    vector<OperadorMutacion> operadores_mutacion;   // operadores aplicados a los genes mutados
+    vector<double> pesos_mutacion;                  // pesos acumulados de cada operador
+    bool fusionado;                     // producir cada hijo con producirHijoFusionado
+    long evaluaciones_restauradas;      // evaluaciones hechas antes del checkpoint reanudado
+
+    /*
+     * Constructor
+     * - Recibe: parámetros del AE, instancia, semilla maestra y número de hilos
+     * Cada trabajador w recibe un generador (del tipo tipo_rng_defecto) sembrado
+     * con (semilla, w), por lo que la misma semilla, tipo de generador y cantidad
+     * de hilos reproducen exactamente la ejecución.
+     */
+    AlgoritmoEvolutivo(int pop_size, double mut_rate, int k, int T, const Instancia& inst_ref,
+                       uint32_t semilla = 0, int hilos = 1, int max_controles = 0, int elite = 1)
+        : tam_poblacion(pop_size), tasa_mutacion(mut_rate), k_drones(k), T_ticks(T), inst(inst_ref),
+          num_hilos(max(1, hilos)), num_elite(max(1, min(elite, pop_size))), tam_torneo(5), idx_mejor(0),
+          medir_tiempos(false), tiempos_fase_hilo(max(1, hilos), array<double, NUM_FASES>{}),
+          lotes_hilo(max(1, hilos)), generacion(0), intervalo_busqueda(0), top_busqueda(0),
+          pasos_busqueda(0), celdas_reparacion(max(1, hilos)), reservas_reparacion(max(1, hilos)),
+          consultas_cache(0), aciertos_cache(0), traza(nullptr), indice_traza(0),
+          evaluaciones_traza(0), fases_traza{}, estado_inicial(nullptr),
+          operadores_mutacion(1, mutacionPuntual), pesos_mutacion(1, 1.0), fusionado(false),
+          evaluaciones_restauradas(0) {
+        motores.reserve(num_hilos);
+        for (int w = 0; w < num_hilos; ++w) {
+            generadores.emplace_back(semilla, static_cast<uint32_t>(w));
+            motores.emplace_back(inst_ref, max_controles);
+        }
+        if (num_hilos > 1) {
+            pool.reset(new PoolHilos(num_hilos));
+        }
+    }
+
+    /*
+     * repartir
+     * - Recibe: rango de índices [inicio, fin) y tarea(desde, hasta, trabajador)
+     * Divide el rango en bloques contiguos fijos, uno por trabajador, de modo que
+     * la asignación de individuos a flujos aleatorios sea determinista.
+     * - Retorna: void
+     */
+    void repartir(int inicio, int fin, const function<void(int, int, int)>& tarea) {
+        int total = fin - inicio;
+        auto bloque = [&](int w) {
+            int desde = inicio + static_cast<long>(total) * w / num_hilos;
+            int hasta = inicio + static_cast<long>(total) * (w + 1) / num_hilos;
+            tarea(desde, hasta, w);
+        };
+        if (pool) {
+            pool->ejecutar(bloque);
+        } else {
+            bloque(0);
+        }
+    }
+
+    /*
+     * evaluarLoteHilo
+     * - Recibe: índice del trabajador
+     * Evalúa de una vez todas las tareas acumuladas en lotes_hilo[w] con el
+     * motor del trabajador.
+     * - Retorna: void (modifica fitness de los individuos del lote)
+     */
+    void evaluarLoteHilo(int w) {
+        vector<TareaEvaluacion>& lote = lotes_hilo[w];
+        auto marca = marcaTiempo();
+        motores[w].evaluarLote(lote.data(), lote.size(), T_ticks);
+        acumularFase(w, FASE_EVALUACION, marca);
+    }
+
+    /*
+     * marcaTiempo
+     * - Recibe: nada
+     * - Retorna: instante actual si se miden tiempos (si no, un valor vacío sin costo)
+     */
+    chrono::steady_clock::time_point marcaTiempo() const {
+        return medir_tiempos ? chrono::steady_clock::now() : chrono::steady_clock::time_point();
+    }
+
+    /*
+     * acumularFase
+     * - Recibe: trabajador, fase, marca de inicio
+     * Suma a la fase el tiempo transcurrido desde la marca y la avanza al instante actual.
+     * - Retorna: void
+     */
+    void acumularFase(int w, int fase, chrono::steady_clock::time_point& marca) {
+        if (!medir_tiempos) return;
+        auto ahora = chrono::steady_clock::now();
+        tiempos_fase_hilo[w][fase] += chrono::duration<double>(ahora - marca).count();
+        marca = ahora;
+    }
+
+    /*
+     * tiempoFase
+     * - Recibe: fase
+     * - Retorna: segundos acumulados en la fase (suma de todos los trabajadores)
+     */
+    double tiempoFase(int fase) const {
+        double total = 0.0;
+        for (const auto& tiempos : tiempos_fase_hilo) total += tiempos[fase];
+        return total;
+    }
+
+    /*
+     * ticksTotales
+     * - Recibe: nada
+     * - Retorna: ticks simulados por todos los trabajadores
+     */
+    long ticksTotales() const {
+        long total = 0;
+        for (const MotorEvaluacion& m : motores) total += m.ticksSimulados();
+        for (const MotorEvaluacion& m : motores_locales) total += m.ticksSimulados();
+        return total;
+    }
+
+    /*
+     * evaluacionesTotales
+     * - Recibe: nada
+     * - Retorna: individuos evaluados por todos los trabajadores
+     */
+    long evaluacionesTotales() const {
+        long total = evaluaciones_restauradas;
+        for (const MotorEvaluacion& m : motores) total += m.evaluacionesRealizadas();
+        for (const MotorEvaluacion& m : motores_locales) total += m.evaluacionesRealizadas();
+        return total;
+    }
+
+    /*
+     * tasaAciertosCache
+     * - Recibe: nada
+     * - Retorna: fracción de hijos cuyo fitness salió de la caché (0 sin consultas)
+     */
+    double tasaAciertosCache() const {
+        return consultas_cache > 0 ? static_cast<double>(aciertos_cache) / consultas_cache : 0.0;
+    }
+
+    /*
+     * inicializarPoblacion
+     * - Recibe: opcionalmente, planes de otra ejecución con los que arrancar
+     *   (arranque en caliente desde un checkpoint; ver adaptarPlan)
+     * Crea la población inicial con individuos aleatorios (los primeros
+     * adaptados de los planes previos, si los hay) y luego los evalúa en lote.
+     * - Retorna: modifica la población
+     */
+    void inicializarPoblacion(const vector<Individuo>* previos = nullptr) {
+        poblacion.assign(tam_poblacion, Individuo());
+        repartir(0, tam_poblacion, [this, previos](int desde, int hasta, int w) {
+            vector<TareaEvaluacion>& lote = lotes_hilo[w];
+            lote.clear();
+            auto marca = marcaTiempo();
+            for (int i = desde; i < hasta; ++i) {
+                Individuo& ind = poblacion[i];
+                ind.inicializarAleatorio(k_drones, T_ticks, inst, generadores[w]);
+                if (previos && i < static_cast<int>(previos->size())) adaptarPlan((*previos)[i], ind);
+                if (estado_inicial) ind.base_ids = estado_inicial->base_ids;
+                acumularFase(w, FASE_INICIALIZACION, marca);
+                repararIndividuo(ind, w); // Garantizar población inicial válida
+                acumularFase(w, FASE_REPARACION, marca);
+                if (cache) {
+                    claves_hijos[i] = hashPlan(ind);
+                    hijos_en_cache[i] = 0;
+                }
+                lote.push_back({&ind, nullptr, 0});
+            }
+            evaluarLoteHilo(w);
+        });
+        if (cache) guardarEnCache(0);
+        actualizarMejor();
+        if (traza) registrarTraza();
+    }
+
+    /*
+     * adaptarPlan
+     * - Recibe: plan de otra ejecución (puede tener otro k, otro T o venir de
+     *   otra instancia), individuo ya inicializado al azar
+     * El dron d toma la base (módulo el número de bases, siempre dentro de
+     * la instancia) y los primeros min(T, T previo) ticks del dron d módulo k
+     * previo; el resto conserva las acciones aleatorias. Las acciones ya
+     * vienen validadas por leerCheckpoint. La reparación posterior lo vuelve factible.
+     * - Retorna: void (modifica el individuo)
+     */
+    void adaptarPlan(const Individuo& previo, Individuo& ind) const {
+        int k_previo = previo.base_ids.size();
+        int ticks = min(T_ticks, previo.ticks);
+        int num_bases = inst.bases.size();
+        for (int d = 0; d < k_drones; ++d) {
+            int origen = d % k_previo;
+            ind.base_ids[d] = (previo.base_ids[origen] % num_bases + num_bases) % num_bases;
+            memcpy(ind.plan(d), previo.plan(origen), ticks);
+        }
+    }
+
+    /*
+     * serializarEstado
+     * - Recibe: buffer destino, semilla maestra, estado del control de parada
+     * Escribe un checkpoint (formato de CabeceraCheckpoint) con la población,
+     * la generación, el estado de cada generador y los contadores. Solo copia
+     * memoria; la escritura a disco la hace EscritorCheckpoint.
+     * - Retorna: void (reemplaza el contenido del buffer reutilizando su memoria)
+     */
+    void serializarEstado(vector<char>& buffer, uint32_t semilla, const EstadoParada& parada) const {
+        CabeceraCheckpoint c = {};
+        memcpy(c.firma, FIRMA_CHECKPOINT, sizeof(c.firma));
+        c.version = VERSION_CHECKPOINT;
+        c.k = k_drones;
+        c.T = T_ticks;
+        c.poblacion = poblacion.size();
+        c.generadores = generadores.size();
+        c.tipo_rng = generadores[0].tipoGenerador();
+        c.semilla = semilla;
+        c.generacion = generacion;
+        c.huella_instancia = inst.huella();
+        c.evaluaciones = evaluacionesTotales();
+        c.parada = parada;
+        c.configuracion = configuracion();
+        
+        buffer.clear();
+        auto agregar = [&buffer](const void* datos, size_t n) {
+            const char* bytes = static_cast<const char*>(datos);
+            buffer.insert(buffer.end(), bytes, bytes + n);
+        };
+        agregar(&c, sizeof(c));
+        for (const GeneradorRng& gen : generadores) {
+            string estado = gen.estado();
+            uint32_t largo = estado.size();
+            agregar(&largo, sizeof(largo));
+            agregar(estado.data(), largo);
+        }
+        for (const Individuo& ind : poblacion) {
+            uint8_t valido = ind.es_valido;
+            agregar(ind.base_ids.data(), k_drones * sizeof(int32_t));
+            agregar(ind.acciones.data(), static_cast<size_t>(k_drones) * T_ticks);
+            agregar(&ind.fitness, sizeof(double));
+            agregar(&valido, 1);
+        }
+    }
+
+    /*
+     * configuracion
+     * - Recibe: nada
+     * - Retorna: parámetros que se guardan en la cabecera de un checkpoint
+     */
+    ConfiguracionCheckpoint configuracion() const {
+        auto mezclar = [](uint64_t h, uint64_t v) {
+            h = (h ^ v) * 0x9E3779B97F4A7C15ULL;
+            return h ^ (h >> 29);
+        };
+        uint64_t huella_operadores = 0x452821E638D01377ULL;
+        for (size_t i = 0; i < operadores_mutacion.size(); ++i) {
+            uint64_t indice = 0;
+            while (indice < size(OPERADORES_MUTACION) &&
+                   OPERADORES_MUTACION[indice].operador != operadores_mutacion[i]) {
+                indice++;
+            }
+            uint64_t peso;
+            memcpy(&peso, &pesos_mutacion[i], sizeof(peso));
+            huella_operadores = mezclar(mezclar(huella_operadores, indice), peso);
+        }
+        ConfiguracionCheckpoint c = {};
+        c.tasa_mutacion = tasa_mutacion;
+        c.elite = num_elite;
+        c.torneo = tam_torneo;
+        c.fusionado = fusionado;
+        c.intervalo_memetico = intervalo_busqueda;
+        c.top_memetico = intervalo_busqueda > 0 ? top_busqueda : 0;
+        c.pasos_memetico = intervalo_busqueda > 0 ? pasos_busqueda : 0;
+        c.max_controles = motores[0].presupuestoControles();
+        c.evaluador_perezoso = motores[0].evaluacionPerezosa();
+        c.huella_operadores = huella_operadores;
+        c.entradas_cache = cache ? cache->capacidad() : 0;
+        return c;
+    }
+
+    /*
+     * restaurarEstado
+     * - Recibe: checkpoint de una ejecución con los mismos k, T, población,
+     *   hilos, tipo de generador y configuración (ConfiguracionCheckpoint, salvo
+     *   la caché) en lugar de inicializarPoblacion
+     * Recupera población, generación, generadores y evaluaciones, de modo que
+     * las generaciones siguientes son idénticas a las de la ejecución original.
+     * Los puntos de control de simulación y la caché de fitness no se guardan
+     * y se reconstruyen. Con caché cambian los aciertos y las evaluaciones
+     * contadas, y con ellas el corte por --max-evaluaciones: ejecutarPrograma
+     * rechaza esa combinación al reanudar.
+     * - Retorna: void (lanza runtime_error si el checkpoint no es compatible)
+     */
+    void restaurarEstado(const Checkpoint& ck) {
+        const CabeceraCheckpoint& c = ck.cabecera;
+        if (c.k != k_drones || c.T != T_ticks || c.poblacion != tam_poblacion ||
+            c.generadores != static_cast<int>(generadores.size())) {
+            throw runtime_error("el checkpoint es de k=" + to_string(c.k) + ", T=" + to_string(c.T) +
+                                ", población " + to_string(c.poblacion) + " y " + to_string(c.generadores) +
+                                " hilos; la ejecución debe usar los mismos valores");
+        }
+        if (c.tipo_rng != generadores[0].tipoGenerador()) {
+            throw runtime_error("el checkpoint usa otro tipo de generador (--rng)");
+        }
+        const ConfiguracionCheckpoint& guardada = c.configuracion;
+        ConfiguracionCheckpoint actual = configuracion();
+        auto exigir = [](bool igual, const string& opcion, const string& valor_guardado, const string& valor_actual) {
+            if (!igual) {
+                throw runtime_error("el checkpoint se generó con " + opcion + " " + valor_guardado +
+                                    " y la ejecución usa " + valor_actual + "; al reanudar deben coincidir");
+            }
+        };
+        auto nombre_memetico = [](const ConfiguracionCheckpoint& x) {
+            return x.intervalo_memetico > 0 ? to_string(x.intervalo_memetico) + "/" + to_string(x.top_memetico) +
+                                                  "/" + to_string(x.pasos_memetico)
+                                            : string("0");
+        };
+        exigir(guardada.tasa_mutacion == actual.tasa_mutacion, "--mutacion",
+               to_string(guardada.tasa_mutacion), to_string(actual.tasa_mutacion));
+        exigir(guardada.elite == actual.elite, "--elite", to_string(guardada.elite), to_string(actual.elite));
+        exigir(guardada.torneo == actual.torneo, "--torneo", to_string(guardada.torneo), to_string(actual.torneo));
+        exigir(guardada.fusionado == actual.fusionado, "--fusionado", guardada.fusionado ? "activado" : "desactivado",
+               actual.fusionado ? "activado" : "desactivado");
+        exigir(guardada.intervalo_memetico == actual.intervalo_memetico &&
+                   guardada.top_memetico == actual.top_memetico && guardada.pasos_memetico == actual.pasos_memetico,
+               "--memetico/--memetico-top/--memetico-pasos", nombre_memetico(guardada), nombre_memetico(actual));
+        exigir(guardada.max_controles == actual.max_controles, "--controles",
+               to_string(guardada.max_controles), to_string(actual.max_controles));
+        exigir(guardada.evaluador_perezoso == actual.evaluador_perezoso, "--evaluador",
+               guardada.evaluador_perezoso ? "perezoso" : "denso", actual.evaluador_perezoso ? "perezoso" : "denso");
+        if (guardada.huella_operadores != actual.huella_operadores) {
+            throw runtime_error("el checkpoint se generó con otros --operadores o pesos; al reanudar deben coincidir");
+        }
+        for (const Individuo& ind : ck.poblacion) {
+            for (int base : ind.base_ids) {
+                if (base >= static_cast<int>(inst.bases.size())) {
+                    throw runtime_error("el checkpoint usa la base " + to_string(base) +
+                                        ", que no existe en la instancia");
+                }
+            }
+        }
+        poblacion = ck.poblacion;
+        for (size_t w = 0; w < generadores.size(); ++w) {
+            generadores[w].restaurarEstado(ck.estados_rng[w]);
+        }
+        generacion = c.generacion;
+        evaluaciones_restauradas = c.evaluaciones;
+        evaluaciones_traza = c.evaluaciones;
+        actualizarMejor();
+    }
+
+    /*
+     * fijarEstadoInicial
+     * - Recibe: estado de la misión al inicio de la ventana (nullptr = bases)
+     * Hace que la inicialización, la mutación, la reparación y todos los motores
+     * partan de ese estado; las bases de los individuos quedan fijas.
+     * - Retorna: void
+     */
+    void fijarEstadoInicial(const EstadoSimulacion* estado) {
+        estado_inicial = estado;
+        for (MotorEvaluacion& m : motores) m.fijarEstadoInicial(estado);
+        for (MotorEvaluacion& m : motores_locales) m.fijarEstadoInicial(estado);
+    }
+
+    /*
+     * posicionInicial
+     * - Recibe: individuo, dron d
+     * - Retorna: celda del dron al inicio del plan (su base o la del estado inicial)
+     */
+    const Coordenada& posicionInicial(const Individuo& ind, int d) const {
+        return estado_inicial ? estado_inicial->posiciones[d] : inst.bases[ind.base_ids[d]];
+    }
+
+    /*
+     * sembrarIndividuo
+     * - Recibe: plan de k x T acciones (por ejemplo, el resto del mejor plan de
+     *   la ventana anterior), ya inicializada la población
+     * Repara y evalúa el plan y lo incorpora en lugar del peor individuo si lo supera.
+     * - Retorna: true si el plan entró a la población
+     */
+    bool sembrarIndividuo(Individuo& ind) {
+        if (estado_inicial) ind.base_ids = estado_inicial->base_ids;
+        repararIndividuo(ind);
+        motores[0].evaluar(ind, T_ticks);
+        return recibirInmigrante(ind);
+    }
+
+    /*
+     * activarTraza
+     * - Recibe: traza de convergencia (compartida entre islas), índice de esta población
+     * Activa la medición de tiempos por fase y el registro de cada generación.
+     * - Retorna: void
+     */
+    void activarTraza(TrazaConvergencia* t, int indice) {
+        traza = t;
+        indice_traza = indice;
+        medir_tiempos = true;
+    }
+
+    /*
+     * registrarTraza
+     * - Recibe: nada (usa la población actual)
+     * Resume la generación en un recorrido O(n) de la población (mejor, media,
+     * peor y fracción de válidos) junto con las evaluaciones y el tiempo de cada
+     * fase desde el registro anterior, y lo agrega a la traza.
+     * - Retorna: void
+     */
+    void registrarTraza() {
+        RegistroGeneracion r;
+        r.isla = indice_traza;
+        r.generacion = generacion;
+        r.tiempo_s = traza->segundos();
+        long evaluaciones = evaluacionesTotales();
+        r.evaluaciones = evaluaciones - evaluaciones_traza;
+        evaluaciones_traza = evaluaciones;
+
+        double suma = 0.0;
+        double peor = poblacion[0].fitness;
+        int validos = 0;
+        for (const Individuo& ind : poblacion) {
+            suma += ind.fitness;
+            peor = max(peor, ind.fitness);
+            validos += ind.es_valido;
+        }
+        r.mejor = poblacion[idx_mejor].fitness;
+        r.media = suma / poblacion.size();
+        r.peor = peor;
+        r.fraccion_validos = static_cast<double>(validos) / poblacion.size();
+
+        for (int f = 0; f < NUM_FASES; ++f) {
+            double t = tiempoFase(f);
+            r.tiempo_fase_ms[f] = (t - fases_traza[f]) * 1000.0;
+            fases_traza[f] = t;
+        }
+        traza->registrar(r);
+    }
+
+    /*
+     * activarCache
+     * - Recibe: número de entradas de la caché de fitness (0 = desactivar)
+     * Antes de evaluar cada hijo se busca el hash de su cromosoma; si ya se
+     * evaluó un plan idéntico se copia su fitness y el hijo no se simula.
+     * - Retorna: void
+     */
+    void activarCache(size_t entradas) {
+        if (entradas == 0) {
+            cache.reset();
+            return;
+        }
+        cache.reset(new CacheFitness(entradas));
+        claves_hijos.assign(tam_poblacion, 0);
+        hijos_en_cache.assign(tam_poblacion, 0);
+    }
+
+    /*
+     * buscarEnCache
+     * - Recibe: individuo ya reparado, su posición en la nueva población
+     * Solo lee la caché, así que varios trabajadores pueden consultarla a la vez.
+     * - Retorna: true si el fitness se tomó de la caché
+     */
+    bool buscarEnCache(Individuo& ind, int i) {
+        claves_hijos[i] = hashPlan(ind);
+        hijos_en_cache[i] = cache->buscar(claves_hijos[i], ind);
+        return hijos_en_cache[i];
+    }
+
+    /*
+     * guardarEnCache
+     * - Recibe: primer índice de la población con individuos nuevos
+     * Inserta los individuos evaluados en esta generación y cuenta los aciertos.
+     * Se llama desde un solo hilo, después de la fase paralela.
+     * - Retorna: void
+     */
+    void guardarEnCache(int desde) {
+        for (int i = desde; i < tam_poblacion; ++i) {
+            if (hijos_en_cache[i]) {
+                aciertos_cache++;
+            } else {
+                cache->insertar(claves_hijos[i], poblacion[i]);
+            }
+        }
+    }
+
+    /*
+     * actualizarMejor
+     * - Recibe: nada (usa la población actual)
+     * Recorre la población una vez para ubicar al mejor individuo (O(n)).
+     * - Retorna: void (actualiza idx_mejor)
+     */
+    void actualizarMejor() {
+        idx_mejor = 0;
+        for (int i = 1; i < static_cast<int>(poblacion.size()); ++i) {
+            if (poblacion[i].fitness < poblacion[idx_mejor].fitness) {
+                idx_mejor = i;
+            }
+        }
+    }
+
+    /*
+     * seleccionarElite
+     * - Recibe: nada (usa la población actual)
+     * Ordena parcialmente una permutación de índices para dejar en
+     * ranking[0..num_elite) a los mejores, sin mover ningún cromosoma.
+     * - Retorna: void (actualiza ranking)
+     */
+    void seleccionarElite() {
+        ordenarMejores(num_elite);
+    }
+
+    /*
+     * ordenarMejores
+     * - Recibe: cantidad m de individuos (1 <= m <= tamaño de la población)
+     * Deja en ranking[0..m) los índices de los m mejores, de mejor a peor.
+     * Con m = 1 basta idx_mejor (O(n)); en general usa nth_element.
+     * Empates se rompen por índice para que el resultado sea determinista.
+     * - Retorna: void (actualiza ranking)
+     */
+    void ordenarMejores(int m) {
+        ranking.resize(poblacion.size());
+        if (m == 1) {
+            ranking[0] = idx_mejor;
+            return;
+        }
+        for (size_t i = 0; i < ranking.size(); ++i) ranking[i] = i;
+        auto mejor_que = [this](int a, int b) {
+            if (poblacion[a].fitness != poblacion[b].fitness) {
+                return poblacion[a].fitness < poblacion[b].fitness;
+            }
+            return a < b;
+        };
+        nth_element(ranking.begin(), ranking.begin() + (m - 1), ranking.end(), mejor_que);
+        sort(ranking.begin(), ranking.begin() + m, mejor_que);
+    }
+
+    /*
+     * recibirInmigrante
+     * - Recibe: individuo ya evaluado que llega de otra isla
+     * Reemplaza al peor individuo de la población si el inmigrante es mejor.
+     * El inmigrante se intercambia (sin copiar) con el individuo reemplazado.
+     * - Retorna: true si el inmigrante entró a la población
+     */
+    bool recibirInmigrante(Individuo& inmigrante) {
+        int peor = 0;
+        for (int i = 1; i < static_cast<int>(poblacion.size()); ++i) {
+            if (poblacion[i].fitness > poblacion[peor].fitness) {
+                peor = i;
+            }
+        }
+        if (!(inmigrante.fitness < poblacion[peor].fitness)) return false;
+        swap(poblacion[peor], inmigrante);
+        if (poblacion[peor].fitness < poblacion[idx_mejor].fitness) {
+            idx_mejor = peor;
+        }
+        return true;
+    }
+
+
+    /*
+     * seleccionarPorTorneo
+     * - Recibe: tamaño del torneo, generador del trabajador
+     * Selecciona un individuo mediante torneo (compara individuos aleatorios).
+     * - Retorna: referencia al mejor individuo del torneo
+     */
+    const Individuo& seleccionarPorTorneo(int tam_torneo, GeneradorRng& gen) const {
+        uniform_int_distribution<int> dist_pop(0, tam_poblacion - 1);
+        const Individuo* mejor_del_torneo = &poblacion[dist_pop(gen)];
+
+        for (int i = 1; i < tam_torneo; ++i) {
+            const Individuo* retador = &poblacion[dist_pop(gen)];
+            if (retador->fitness < mejor_del_torneo->fitness) {
+                mejor_del_torneo = retador;
+            }
+        }
+        return *mejor_del_torneo;
+    }
+
+    /*
+     * cruzarUnPunto
+     * - Recibe: dos individuos padres, generador del trabajador, individuo destino
+     * Escribe en hijo la combinación de acciones de ambos padres en un punto de
+     * corte temporal (un bloque contiguo de cada padre por dron).
+     * - Retorna: void (sobrescribe hijo reutilizando su memoria)
+     */
+    void cruzarUnPunto(const Individuo& p1, const Individuo& p2, GeneradorRng& gen,
+                       Individuo& hijo) const {
+        hijo.redimensionar(k_drones, T_ticks);
+        copy(p1.base_ids.begin(), p1.base_ids.end(), hijo.base_ids.begin());
+
+        uniform_int_distribution<int> dist_corte(1, T_ticks - 2);
+        int punto_corte_t = dist_corte(gen);
+
+        for (int d = 0; d < k_drones; ++d) {
+            memcpy(hijo.plan(d), p1.plan(d), punto_corte_t);
+            memcpy(hijo.plan(d) + punto_corte_t, p2.plan(d) + punto_corte_t,
+                   T_ticks - punto_corte_t);
+        }
+    }
+
+    /*
+     * fijarOperadoresMutacion
+     * - Recibe: operadores de mutación con su peso relativo (al menos uno con peso > 0)
+     * Cada gen mutado aplica uno de los operadores elegido según su peso.
+     * - Retorna: void
+     */
+    void fijarOperadoresMutacion(const vector<pair<OperadorMutacion, double>>& operadores) {
+        operadores_mutacion.clear();
+        pesos_mutacion.clear();
+        double acumulado = 0.0;
+        for (const auto& op : operadores) {
+            if (op.second <= 0.0) continue;
+            acumulado += op.second;
+            operadores_mutacion.push_back(op.first);
+            pesos_mutacion.push_back(acumulado);
+        }
+    }
+
+    /*
+     * mutar
+     * - Recibe: individuo a mutar, generador del trabajador
+     * Cada gen se muta con probabilidad tasa_mutacion, pero en lugar de sortear
+     * gen por gen se sortea la distancia al próximo gen mutado (distribución
+     * geométrica), así que los sorteos son proporcionales a las mutaciones y no
+     * a k·T. La posición del dron se avanza con la tabla de desplazamientos solo
+     * hasta el gen mutado, y a ese gen se le aplica un operador de mutación.
+     * - Retorna: void (modifica el individuo recibido)
+     */
+    void mutar(Individuo& ind, GeneradorRng& gen) const {
+        if (!(tasa_mutacion > 0.0) || operadores_mutacion.empty()) return;
+        long total = static_cast<long>(k_drones) * T_ticks;
+        bool todos = tasa_mutacion >= 1.0;
+        geometric_distribution<long> dist_salto(todos ? 0.5 : tasa_mutacion);
+        uniform_real_distribution<double> dist_operador(0.0, pesos_mutacion.back());
+        
+        int dron = -1;
+        int tick = 0;               // tick al que corresponde pos
+        Coordenada pos = {0, 0};
+        for (long g = todos ? 0 : dist_salto(gen); g < total; g += 1 + (todos ? 0 : dist_salto(gen))) {
+            int d = g / T_ticks;
+            int t = g % T_ticks;
+            if (d != dron) {
+                dron = d;
+                tick = 0;
+                pos = posicionInicial(ind, d);
+            }
+            const uint8_t* plan_dron = ind.plan(d);
+            for (; tick < t; ++tick) {
+                pos.fila += DELTA_FILA[plan_dron[tick]];
+                pos.col += DELTA_COL[plan_dron[tick]];
+            }
+            
+            size_t op = 0;
+            if (operadores_mutacion.size() > 1) {
+                double r = dist_operador(gen);
+                while (op + 1 < pesos_mutacion.size() && r >= pesos_mutacion[op]) op++;
+            }
+            operadores_mutacion[op](inst, ind, d, t, pos, gen);
+        }
+    }
+
+    /*
+     * repararIndividuo
+     * - Recibe: individuo a reparar, índice del trabajador (buffers de reserva)
+     * Simula todos los drones tick a tick reservando la celda destino de cada
+     * uno. Si la acción de un dron lo saca de la grilla, lo lleva a un obstáculo
+     * o a una celda ya reservada en ese tick (fuera de bases), se reemplaza por
+     * "permanecer" y, si tampoco está libre, por la acción libre que más lo
+     * acerque a una urgencia. Así el plan resultante es factible salvo que un
+     * dron quede completamente rodeado. Repara los drones de ind.base_ids (en
+     * el modo multiobjetivo, solo los activos).
+     * - Retorna: void (modifica el individuo recibido)
+     */
+    void repararIndividuo(Individuo& ind, int w = 0) {
+        vector<int>& celdas = celdas_reparacion[w];
+        vector<uint64_t>& reservadas = reservas_reparacion[w];
+        int k = ind.base_ids.size();
+        celdas.resize(k);
+        reservadas.assign(inst.bits_base.size(), 0);
+        
+        for (int d = 0; d < k; ++d) {
+            const Coordenada& pos_inicial = posicionInicial(ind, d);
+            celdas[d] = inst.indiceCelda(pos_inicial.fila, pos_inicial.col);
+        }
+        
+        for (int t = 0; t < T_ticks; ++t) {
+            for (int d = 0; d < k; ++d) {
+                uint8_t& accion = ind.accion(d, t);
+                accion = accionReparada(celdas[d], accion, reservadas.data());
+                int destino = celdas[d] + DELTA_FILA[accion] * inst.columnas + DELTA_COL[accion];
+                reservadas[destino >> 6] |= uint64_t(1) << (destino & 63);
+                celdas[d] = destino;
+            }
+            
+            // Liberar las reservas del tick (solo las palabras tocadas)
+            for (int d = 0; d < k; ++d) {
+                reservadas[celdas[d] >> 6] = 0;
+            }
+        }
+    }
+
+    /*
+     * accionReparada
+     * - Recibe: celda actual del dron, acción del plan, celdas reservadas en el tick
+     * - Retorna: la acción si es válida y su destino está libre; si no,
+     *   "permanecer" o la acción libre que más acerque a una urgencia
+     *   ("permanecer" si el dron está rodeado, para que la evaluación lo penalice)
+     */
+    int accionReparada(int celda, int accion, const uint64_t* reservadas) const {
+        const uint64_t* base = inst.bits_base.data();
+        auto libre = [&](int c) {
+            return !(reservadas[c >> 6] & ~base[c >> 6] & (uint64_t(1) << (c & 63)));
+        };
+        unsigned mascara = inst.movimientos_validos[celda];
+        if ((mascara & (1u << accion)) &&
+            libre(celda + DELTA_FILA[accion] * inst.columnas + DELTA_COL[accion])) {
+            return accion;
+        }
+        
+        int mejor_accion = -1;
+        int mejor_distancia = 0;
+        for (int a = 0; a < 9; ++a) {
+            if (!(mascara & (1u << a))) continue;
+            int candidata = celda + DELTA_FILA[a] * inst.columnas + DELTA_COL[a];
+            if (!libre(candidata)) continue;
+            if (a == 0) return 0;
+            int distancia = inst.distancia_urgencia[candidata];
+            if (distancia < 0) distancia = numeric_limits<int>::max();
+            if (mejor_accion < 0 || distancia < mejor_distancia) {
+                mejor_accion = a;
+                mejor_distancia = distancia;
+            }
+        }
+        return max(mejor_accion, 0);
+    }
+
+    /*
+     * producirHijoFusionado
+     * - Recibe: padres, individuo destino, índice del trabajador
+     * Produce y evalúa el hijo en una sola pasada tick a tick: para cada gen
+     * toma la acción del padre que corresponde según el punto de corte, la muta
+     * si le toca (muestreo geométrico sobre el orden tick-dron), la repara
+     * contra las celdas reservadas en el tick y, una vez escritos los k genes
+     * del tick, lo simula en el motor del trabajador. Si el plan resulta
+     * inválido se termina de construir sin seguir simulando. Equivale a
+     * cruzarUnPunto + mutar + repararIndividuo + evaluar, con otro orden de
+     * sorteos; solo admite operadores que modifican el gen actual.
+     * - Retorna: void (escribe plan, fitness y es_valido del hijo)
+     */
+    void producirHijoFusionado(const Individuo& p1, const Individuo& p2, Individuo& hijo, int w) {
+        GeneradorRng& gen = generadores[w];
+        MotorEvaluacion& motor = motores[w];
+        vector<int>& celdas = celdas_reparacion[w];
+        vector<uint64_t>& reservadas = reservas_reparacion[w];
+        hijo.redimensionar(k_drones, T_ticks);
+        copy(p1.base_ids.begin(), p1.base_ids.end(), hijo.base_ids.begin());
+        uniform_int_distribution<int> dist_corte(1, T_ticks - 2);
+        int corte = dist_corte(gen);
+        
+        celdas.resize(k_drones);
+        reservadas.assign(inst.bits_base.size(), 0);
+        for (int d = 0; d < k_drones; ++d) {
+            const Coordenada& pos_inicial = posicionInicial(hijo, d);
+            celdas[d] = inst.indiceCelda(pos_inicial.fila, pos_inicial.col);
+        }
+        
+        long total = static_cast<long>(k_drones) * T_ticks;
+        bool mutar_todos = tasa_mutacion >= 1.0;
+        geometric_distribution<long> dist_salto(mutar_todos ? 0.5 : max(tasa_mutacion, 1e-300));
+        uniform_real_distribution<double> dist_operador(0.0, pesos_mutacion.back());
+        auto salto = [&]() { return mutar_todos ? 0L : dist_salto(gen); };
+        long siguiente = (tasa_mutacion > 0.0) ? salto() : total;
+        
+        motor.iniciarPorTicks(hijo, T_ticks);
+        bool simulando = true;
+        for (int t = 0; t < T_ticks; ++t) {
+            const Individuo& fuente = (t < corte) ? p1 : p2;
+            for (int d = 0; d < k_drones; ++d) {
+                uint8_t& accion = hijo.accion(d, t);
+                accion = fuente.accion(d, t);
+                if (static_cast<long>(t) * k_drones + d == siguiente) {
+                    size_t op = 0;
+                    if (operadores_mutacion.size() > 1) {
+                        double r = dist_operador(gen);
+                        while (op + 1 < pesos_mutacion.size() && r >= pesos_mutacion[op]) op++;
+                    }
+                    Coordenada pos = {celdas[d] / inst.columnas, celdas[d] % inst.columnas};
+                    operadores_mutacion[op](inst, hijo, d, t, pos, gen);
+                    siguiente += 1 + salto();
+                }
+                accion = accionReparada(celdas[d], accion, reservadas.data());
+                int destino = celdas[d] + DELTA_FILA[accion] * inst.columnas + DELTA_COL[accion];
+                reservadas[destino >> 6] |= uint64_t(1) << (destino & 63);
+                celdas[d] = destino;
+            }
+            for (int d = 0; d < k_drones; ++d) {
+                reservadas[celdas[d] >> 6] = 0;
+            }
+            if (simulando) simulando = motor.simularTick(T_ticks);
+        }
+        if (simulando) motor.simularTick(T_ticks);
+    }
+
+    /*
+     * ejecutarGeneracion
+     * - Recibe: nada (usa la población actual)
+     * Aplica elitismo, selección, cruce y mutación para crear nueva generación.
+     * La élite se obtiene sobre índices (seleccionarElite) y se copia una sola vez.
+     * Los hijos se producen y evalúan en paralelo: cada trabajador llena un
+     * bloque fijo de la nueva población usando su propio generador y motor.
+     * Cada trabajador produce primero todos sus hijos y luego los evalúa en lote.
+     * Cada hijo hereda bases y prefijo de p1, así que se evalúa reanudando
+     * la simulación de p1 desde el primer tick modificado.
+     * Con la caché activa, un hijo idéntico a un plan ya evaluado toma su
+     * fitness de ella y no entra al lote.
+     * Con fusionado activo cada hijo se produce y evalúa en una sola pasada
+     * (producirHijoFusionado), sin lote ni caché.
+     * Los hijos se escriben sobre los individuos de poblacion_siguiente (que
+     * conservan su memoria) y al final se intercambian ambos buffers.
+     * - Retorna: void (reemplaza la población actual)
+     */
+    void ejecutarGeneracion() {
+        vector<Individuo>& nueva_poblacion = poblacion_siguiente;
+        nueva_poblacion.resize(tam_poblacion);
+
+        // Elitismo: preservar los num_elite mejores
+        seleccionarElite();
+        for (int e = 0; e < num_elite; ++e) {
+            nueva_poblacion[e] = poblacion[ranking[e]];
+        }
+
+        // Crear nuevos individuos
+        repartir(num_elite, tam_poblacion, [&](int desde, int hasta, int w) {
+            GeneradorRng& gen = generadores[w];
+            vector<TareaEvaluacion>& lote = lotes_hilo[w];
+            lote.clear();
+            auto marca = marcaTiempo();
+            for (int i = desde; i < hasta; ++i) {
+                const Individuo& p1 = seleccionarPorTorneo(tam_torneo, gen);
+                const Individuo& p2 = seleccionarPorTorneo(tam_torneo, gen);
+                acumularFase(w, FASE_SELECCION, marca);
+
+                Individuo& hijo = nueva_poblacion[i];
+                if (fusionado) {
+                    producirHijoFusionado(p1, p2, hijo, w);
+                    acumularFase(w, FASE_FUSIONADA, marca);
+                    continue;
+                }
+                cruzarUnPunto(p1, p2, gen, hijo);
+                acumularFase(w, FASE_CRUCE, marca);
+                mutar(hijo, gen);
+                acumularFase(w, FASE_MUTACION, marca);
+                repararIndividuo(hijo, w); // Garantizar que el hijo sea válido espacialmente
+                acumularFase(w, FASE_REPARACION, marca);
+                if (!cache || !buscarEnCache(hijo, i)) {
+                    lote.push_back({&hijo, &p1, primerTickModificado(hijo, p1, T_ticks)});
+                }
+                acumularFase(w, FASE_EVALUACION, marca);
+            }
+            evaluarLoteHilo(w);
+        });
+
+        poblacion.swap(nueva_poblacion);
+        if (cache && !fusionado) {
+            consultas_cache += tam_poblacion - num_elite;
+            guardarEnCache(num_elite);
+        }
+        actualizarMejor();
+
+        generacion++;
+        if (intervalo_busqueda > 0 && generacion % intervalo_busqueda == 0) {
+            busquedaLocal();
+        }
+        if (traza) registrarTraza();
+    }
+
+    /*
+     * activarBusquedaLocal
+     * - Recibe: generaciones entre etapas (0 = desactivar), cantidad de mejores
+     *   individuos a refinar y pasos de búsqueda por individuo
+     * Activa la etapa memética que ejecutarGeneracion aplica cada intervalo
+     * generaciones. Crea un motor con puntos de control por trabajador para
+     * que cada vecino se evalúe reanudando la simulación del individuo base.
+     * Sin drones no hay genes que modificar y la etapa queda desactivada.
+     * - Retorna: void
+     */
+    void activarBusquedaLocal(int intervalo, int top, int pasos) {
+        intervalo_busqueda = k_drones > 0 ? max(0, intervalo) : 0;
+        top_busqueda = max(1, min(top, tam_poblacion));
+        pasos_busqueda = max(1, pasos);
+        motores_locales.clear();
+        motores_locales.reserve(num_hilos);
+        for (int w = 0; w < num_hilos; ++w) {
+            motores_locales.emplace_back(inst, CONTROLES_BUSQUEDA_LOCAL);
+            motores_locales.back().fijarEstadoInicial(estado_inicial);
+        }
+        vecinos_hilo.assign(num_hilos, vector<Individuo>(VECINOS_BUSQUEDA));
+    }
+
+    /*
+     * busquedaLocal
+     * - Recibe: nada (usa la población actual)
+     * Refina en paralelo a los top_busqueda mejores individuos con mejorarIndividuo.
+     * - Retorna: void (puede reemplazar individuos y actualiza idx_mejor)
+     */
+    void busquedaLocal() {
+        ordenarMejores(top_busqueda);
+        repartir(0, top_busqueda, [this](int desde, int hasta, int w) {
+            auto marca = marcaTiempo();
+            for (int i = desde; i < hasta; ++i) {
+                mejorarIndividuo(poblacion[ranking[i]], w);
+            }
+            acumularFase(w, FASE_BUSQUEDA_LOCAL, marca);
+        });
+        actualizarMejor();
+    }
+
+    /*
+     * mejorarIndividuo
+     * - Recibe: individuo a refinar, índice del trabajador
+     * Búsqueda local de mejor mejora alternando dos vecindarios sobre un dron
+     * al azar: (a) las 8 acciones alternativas de un gen (dron d, tick t) y
+     * (b) VECINOS_BUSQUEDA inversiones de un tramo del plan, que dejan al dron
+     * en la misma celda al final del tramo (como un 2-opt sobre la ruta). Los
+     * vecinos se evalúan en lote reanudando desde el punto de control del
+     * individuo previo al primer tick modificado, es decir en O(T - t).
+     * Se acepta el mejor vecino solo si mejora al individuo.
+     * - Retorna: void (modifica el individuo si encontró una mejora)
+     */
+    void mejorarIndividuo(Individuo& ind, int w) {
+        MotorEvaluacion& motor = motores_locales[w];
+        GeneradorRng& gen = generadores[w];
+        vector<Individuo>& vecinos = vecinos_hilo[w];
+        vector<TareaEvaluacion>& lote = lotes_hilo[w];
+
+        // Construir los puntos de control del individuo si no los tiene
+        if (ind.intervalo_control != motor.intervaloControles(T_ticks) || ind.controles_validos == 0) {
+            motor.reconstruirControles(ind, T_ticks);
+        }
+
+        uniform_int_distribution<int> dist_dron(0, k_drones - 1);
+        uniform_int_distribution<int> dist_tick(0, T_ticks - 1);
+        for (int paso = 0; paso < pasos_busqueda; ++paso) {
+            int d = dist_dron(gen);
+            lote.clear();
+            if (paso % 2 == 0) {
+                int t = dist_tick(gen);
+                int actual = ind.accion(d, t);
+                for (int accion = 0, v = 0; accion < 9; ++accion) {
+                    if (accion == actual) continue;
+                    copiarPlan(ind, vecinos[v]);
+                    vecinos[v].accion(d, t) = accion;
+                    lote.push_back({&vecinos[v], &ind, t});
+                    v++;
+                }
+            } else {
+                for (int v = 0; v < VECINOS_BUSQUEDA; ++v) {
+                    int i = dist_tick(gen);
+                    int j = dist_tick(gen);
+                    if (i > j) swap(i, j);
+                    copiarPlan(ind, vecinos[v]);
+                    reverse(vecinos[v].plan(d) + i, vecinos[v].plan(d) + j + 1);
+                    lote.push_back({&vecinos[v], &ind, i});
+                }
+            }
+            motor.evaluarLote(lote.data(), lote.size(), T_ticks);
+
+            int mejor = -1;
+            double fitness_mejor = ind.fitness;
+            for (size_t v = 0; v < lote.size(); ++v) {
+                if (vecinos[v].fitness < fitness_mejor) {
+                    fitness_mejor = vecinos[v].fitness;
+                    mejor = v;
+                }
+            }
+            if (mejor >= 0) swap(ind, vecinos[mejor]);
+        }
+    }
+
+    /*
+     * copiarPlan
+     * - Recibe: individuo origen, individuo destino
+     * Copia bases y acciones (no los puntos de control) reutilizando la memoria del destino.
+     * - Retorna: void
+     */
+    void copiarPlan(const Individuo& origen, Individuo& destino) const {
+        destino.redimensionar(k_drones, T_ticks);
+        copy(origen.base_ids.begin(), origen.base_ids.end(), destino.base_ids.begin());
+        copy(origen.acciones.begin(), origen.acciones.end(), destino.acciones.begin());
+    }
+
+    /*
+     * getMejorIndividuo
+     * - Recibe: nada
+     * Devuelve el individuo con menor fitness, ya ubicado tras cada generación.
+     * - Retorna: referencia al mejor individuo (válida hasta la próxima generación)
+     */
+    const Individuo& getMejorIndividuo() const {
+        return poblacion[idx_mejor];
+    }
+};
+
+// Motivo por el que terminó la evolución
+enum MotivoParada {
+    PARADA_ITERACIONES,    // se alcanzó el máximo de generaciones
+    PARADA_TIEMPO,         // se agotó el tiempo de reloj
+    PARADA_EVALUACIONES,   // se alcanzó el máximo de evaluaciones de fitness
+    PARADA_ESTANCAMIENTO   // el mejor fitness dejó de mejorar
+};
+
+const char* const NOMBRES_PARADA[] = {
+    "iteraciones", "tiempo", "evaluaciones", "estancamiento"
+};
+
+/*
+ * CriterioParada
+ * Límites de la evolución; un valor 0 desactiva el criterio correspondiente.
+ */
+struct CriterioParada {
+    int max_generaciones = 0;
+    double tiempo_max_s = 0.0;
+    long max_evaluaciones = 0;
+    int estancamiento = 0;         // generaciones seguidas sin mejora que detienen la búsqueda
+    double epsilon = 0.0;          // mejora relativa mínima para contar como mejora
+};
+
+/*
+ * ControlParada
+ * Decide antes de cada generación si la evolución debe continuar y registra
+ * el motivo de término. El reloj corre desde su construcción. Una mejora
+ * cuenta solo si baja el mejor fitness de referencia en más de
+ * epsilon·|referencia|. Con varias islas, pasos_por_generacion = número de
+ * islas: cada isla registra sus generaciones y los límites de generaciones y
+ * de estancamiento se miden en rondas de todas las islas.
+ */
+class ControlParada {
+public:
+    explicit ControlParada(const CriterioParada& c, int pasos_generacion = 1)
+        : criterio(c), pasos_por_generacion(max(1, pasos_generacion)), pasos(0),
+          ultimo_progreso(0), evaluaciones(0), hay_referencia(false), referencia(0.0),
+          detenido(false), motivo_parada(PARADA_ITERACIONES),
+          inicio(chrono::high_resolution_clock::now()) {}
+
+    /*
+     * continuar
+     * - Recibe: mejor fitness actual, evaluaciones hechas desde la llamada anterior
+     * Se llama antes de cada generación; si devuelve true, la generación se
+     * cuenta como ejecutada. Una vez que devuelve false sigue devolviendo false.
+     * - Retorna: true si se debe ejecutar otra generación
+     */
+    bool continuar(double mejor_fitness, long evaluaciones_nuevas) {
+        if (detenido) return false;
+        evaluaciones += evaluaciones_nuevas;
+        if (!hay_referencia ||
+            mejor_fitness < referencia - criterio.epsilon * fabs(referencia)) {
+            referencia = mejor_fitness;
+            hay_referencia = true;
+            ultimo_progreso = pasos;
+        }
+
+        if (criterio.max_generaciones > 0 &&
+            pasos >= static_cast<long>(criterio.max_generaciones) * pasos_por_generacion) {
+            detener(PARADA_ITERACIONES);
+        } else if (criterio.tiempo_max_s > 0 && segundos() >= criterio.tiempo_max_s) {
+            detener(PARADA_TIEMPO);
+        } else if (criterio.max_evaluaciones > 0 && evaluaciones >= criterio.max_evaluaciones) {
+            detener(PARADA_EVALUACIONES);
+        } else if (criterio.estancamiento > 0 &&
+                   pasos - ultimo_progreso >= static_cast<long>(criterio.estancamiento) * pasos_por_generacion) {
+            detener(PARADA_ESTANCAMIENTO);
+        } else {
+            pasos++;
+        }
+        return !detenido;
+    }
+
+    /*
+     * estado
+     * - Recibe: nada
+     * - Retorna: contadores, referencia y tiempo transcurrido, para un checkpoint
+     */
+    EstadoParada estado() const {
+        EstadoParada e = {};
+        e.pasos = pasos;
+        e.ultimo_progreso = ultimo_progreso;
+        e.evaluaciones = evaluaciones;
+        e.referencia = referencia;
+        e.segundos = segundos();
+        e.hay_referencia = hay_referencia;
+        return e;
+    }
+
+    /*
+     * restaurar
+     * - Recibe: estado guardado con estado()
+     * Continúa la cuenta desde el checkpoint; el reloj se adelanta el tiempo
+     * que ya había transcurrido.
+     * - Retorna: void
+     */
+    void restaurar(const EstadoParada& e) {
+        pasos = e.pasos;
+        ultimo_progreso = e.ultimo_progreso;
+        evaluaciones = e.evaluaciones;
+        referencia = e.referencia;
+        hay_referencia = e.hay_referencia != 0;
+        detenido = false;
+        inicio = chrono::high_resolution_clock::now() -
+                 chrono::duration_cast<chrono::high_resolution_clock::duration>(chrono::duration<double>(e.segundos));
+    }
+
+    // Generaciones ejecutadas (rondas completas si hay varias islas)
+    int generaciones() const { return pasos / pasos_por_generacion; }
+    MotivoParada motivo() const { return motivo_parada; }
+    double segundos() const {
+        return chrono::duration<double>(chrono::high_resolution_clock::now() - inicio).count();
+    }
+
+private:
+    CriterioParada criterio;
+    int pasos_por_generacion;
+    long pasos;
+    long ultimo_progreso;
+    long evaluaciones;
+    bool hay_referencia;
+    double referencia;
+    bool detenido;
+    MotivoParada motivo_parada;
+    chrono::high_resolution_clock::time_point inicio;
+
+    void detener(MotivoParada motivo) {
+        detenido = true;
+        motivo_parada = motivo;
+    }
+};
+
+/*
+ * ColaMigracion
+ * Cola acotada de un productor y un consumidor, sin bloqueos, por la que una
+ * isla envía individuos a otra. Los espacios se crean al inicio y se reutilizan
+ * (la copia aprovecha la memoria ya reservada del cromosoma). Si la cola está
+ * llena el envío se descarta, de modo que una isla nunca espera a otra.
+ */
+class ColaMigracion {
+public:
+    explicit ColaMigracion(int capacidad)
+        : espacios(capacidad + 1), lectura(0), escritura(0) {}
+
+    /*
+     * enviar
+     * - Recibe: individuo a copiar en la cola (solo desde la isla de origen)
+     * - Retorna: false si la cola estaba llena y el individuo se descartó
+     */
+    bool enviar(const Individuo& ind) {
+        size_t e = escritura.load(memory_order_relaxed);
+        size_t siguiente = (e + 1) % espacios.size();
+        if (siguiente == lectura.load(memory_order_acquire)) return false;
+        espacios[e] = ind;
+        escritura.store(siguiente, memory_order_release);
+        return true;
+    }
+
+    /*
+     * recibir
+     * - Recibe: individuo destino (solo desde la isla de destino); su memoria
+     *   queda en la cola para el próximo envío
+     * - Retorna: false si la cola estaba vacía
+     */
+    bool recibir(Individuo& ind) {
+        size_t l = lectura.load(memory_order_relaxed);
+        if (l == escritura.load(memory_order_acquire)) return false;
+        swap(ind, espacios[l]);
+        lectura.store((l + 1) % espacios.size(), memory_order_release);
+        return true;
+    }
+
+private:
+    vector<Individuo> espacios;
+    alignas(64) atomic<size_t> lectura;    // siguiente posición a leer (consumidor)
+    alignas(64) atomic<size_t> escritura;  // siguiente posición a escribir (productor)
+};
+
+// Topologías de migración entre islas
+enum TopologiaIslas {
+    TOPOLOGIA_ANILLO,    // cada isla envía a la siguiente
+    TOPOLOGIA_COMPLETA   // cada isla envía a todas las demás
+};
+
+/*
+ * ModeloIslas
+ * Varias subpoblaciones (AlgoritmoEvolutivo de un hilo) que evolucionan en
+ * paralelo, una por hilo, cada una con su propia semilla y tasa de mutación.
+ * Cada intervalo_migracion generaciones una isla envía copias de sus mejores
+ * individuos a sus vecinas y recibe los que le hayan llegado, que reemplazan a
+ * sus peores. La migración usa una ColaMigracion por arista, así que las islas
+ * no se sincronizan entre sí (el resultado depende del orden de llegada).
+ */
+class ModeloIslas {
+public:
+    vector<unique_ptr<AlgoritmoEvolutivo>> islas;
+    vector<unique_ptr<ColaMigracion>> colas;  // colas[origen * n + destino] (nullptr sin arista)
+    int intervalo_migracion;
+    int num_migrantes;
+    TopologiaIslas topologia;
+    vector<long> inmigrantes_aceptados;       // por isla
+
+    /*
+     * Constructor
+     * - Recibe: número de islas, parámetros de cada isla (población, tasas de
+     *   mutación asignadas en forma cíclica, torneo, élite, controles), instancia,
+     *   semilla maestra y parámetros de migración
+     * La semilla de cada isla se deriva de la semilla maestra y su índice.
+     */
+    ModeloIslas(int num_islas, int pop_size, const vector<double>& mutaciones, int tam_torneo,
+                int k, int T, const Instancia& inst, uint32_t semilla, int max_controles,
+                int elite, int intervalo, int migrantes, TopologiaIslas topo)
+        : intervalo_migracion(max(1, intervalo)), num_migrantes(max(1, min(migrantes, pop_size))),
+          topologia(topo), inmigrantes_aceptados(num_islas, 0) {
+        GeneradorRng semillas(semilla);
+        for (int i = 0; i < num_islas; ++i) {
+            double mutacion = mutaciones[i % mutaciones.size()];
+            islas.emplace_back(new AlgoritmoEvolutivo(pop_size, mutacion, k, T, inst,
+                                                      static_cast<uint32_t>(semillas()), 1,
+                                                      max_controles, elite));
+            islas.back()->tam_torneo = tam_torneo;
+        }
+        colas.resize(num_islas * num_islas);
+        for (int origen = 0; origen < num_islas; ++origen) {
+            for (int destino = 0; destino < num_islas; ++destino) {
+                bool arista = (topologia == TOPOLOGIA_COMPLETA)
+                    ? origen != destino
+                    : destino == (origen + 1) % num_islas && origen != destino;
+                if (arista) {
+                    colas[origen * num_islas + destino].reset(new ColaMigracion(2 * num_migrantes));
+                }
+            }
+        }
+    }
+
+    /*
+     * migrar
+     * - Recibe: índice de la isla (se llama solo desde su hilo)
+     * Envía copias de los num_migrantes mejores a cada vecina y luego incorpora
+     * los individuos que hayan llegado. Nunca espera a otra isla.
+     * - Retorna: void
+     */
+    void migrar(int i) {
+        int n = islas.size();
+        AlgoritmoEvolutivo& ae = *islas[i];
+        ae.ordenarMejores(num_migrantes);
+        for (int destino = 0; destino < n; ++destino) {
+            ColaMigracion* cola = colas[i * n + destino].get();
+            if (!cola) continue;
+            for (int m = 0; m < num_migrantes; ++m) {
+                cola->enviar(ae.poblacion[ae.ranking[m]]);
+            }
+        }
+
+        Individuo inmigrante;
+        for (int origen = 0; origen < n; ++origen) {
+            ColaMigracion* cola = colas[origen * n + i].get();
+            if (!cola) continue;
+            while (cola->recibir(inmigrante)) {
+                if (ae.recibirInmigrante(inmigrante)) inmigrantes_aceptados[i]++;
+            }
+        }
+    }
+
+    /*
+     * ejecutar
+     * - Recibe: control de parada compartido (creado con una generación = una
+     *   ronda de todas las islas)
+     * Lanza un hilo por isla; cada uno inicializa su población y evoluciona
+     * migrando cada intervalo_migracion generaciones. Antes de cada generación
+     * la isla consulta el control con el mejor fitness global conocido; cuando
+     * un criterio se cumple todas las islas terminan en su siguiente consulta.
+     * - Retorna: void
+     */
+    void ejecutar(ControlParada& parada) {
+        mutex mtx_parada;
+        double mejor_global = numeric_limits<double>::infinity();
+        PoolHilos pool(islas.size());
+        pool.ejecutar([&](int i) {
+            AlgoritmoEvolutivo& ae = *islas[i];
+            ae.inicializarPoblacion();
+            long evaluaciones_previas = 0;
+            for (int g = 0; ; ++g) {
+                if (g > 0 && g % intervalo_migracion == 0) migrar(i);
+                long evaluaciones = ae.evaluacionesTotales();
+                {
+                    lock_guard<mutex> lock(mtx_parada);
+                    mejor_global = min(mejor_global, ae.getMejorIndividuo().fitness);
+                    if (!parada.continuar(mejor_global, evaluaciones - evaluaciones_previas)) break;
+                }
+                evaluaciones_previas = evaluaciones;
+                ae.ejecutarGeneracion();
+            }
+        });
+    }
+
+    /*
+     * getMejorIndividuo
+     * - Recibe: nada
+     * - Retorna: referencia al mejor individuo entre todas las islas
+     */
+    const Individuo& getMejorIndividuo() const {
+        const Individuo* mejor = &islas[0]->getMejorIndividuo();
+        for (const auto& isla : islas) {
+            if (isla->getMejorIndividuo().fitness < mejor->fitness) {
+                mejor = &isla->getMejorIndividuo();
+            }
+        }
+        return *mejor;
+    }
+
+    /*
+     * evaluacionesTotales
+     * - Recibe: nada
+     * - Retorna: evaluaciones de fitness sumadas sobre todas las islas
+     */
+    long evaluacionesTotales() const {
+        long total = 0;
+        for (const auto& isla : islas) total += isla->evaluacionesTotales();
+        return total;
+    }
+};
+
+/*
+ * ResultadoHorizonteRodante
+ * Plan completo armado por ejecutarHorizonteRodante y totales de la ejecución.
+ */
+struct ResultadoHorizonteRodante {
+    Individuo plan;                 // k x T acciones, evaluado desde las bases
+    int ventanas = 0;
+    int generaciones = 0;           // suma sobre todas las ventanas
+    long evaluaciones = 0;
+    long consultas_cache = 0;
+    long aciertos_cache = 0;
+    MotivoParada motivo = PARADA_ITERACIONES;   // de la última ventana
+};
+
+/*
+ * ejecutarHorizonteRodante
+ * - Recibe: instancia, drones k, horizonte total T, ventana W, avance S,
+ *   criterio de parada de cada ventana, semilla maestra y una función que crea
+ *   un AE ya configurado para una ventana (ticks, semilla)
+ * Optimiza la misión por ventanas: evoluciona un plan de W ticks desde el
+ * estado actual, fija sus primeros S ticks, simula ese tramo para obtener el
+ * nuevo estado (posiciones y urgencias) y repite desde ahí. La población solo
+ * guarda planes de W ticks, así que la memoria no depende de T y el tiempo
+ * crece linealmente con T. El resto no fijado del mejor plan (W - S ticks)
+ * se siembra en la población de la ventana siguiente. Las bases se eligen en
+ * la primera ventana. Si el tramo fijado resulta inválido se detiene y el
+ * resto del plan queda en "permanecer".
+ * - Retorna: plan completo de T ticks con su fitness y totales de la ejecución
+ */
+ResultadoHorizonteRodante ejecutarHorizonteRodante(
+        const Instancia& inst, int k, int T, int W, int S, const CriterioParada& criterio,
+        uint32_t semilla, const function<unique_ptr<AlgoritmoEvolutivo>(int, uint32_t)>& crear_ae) {
+    ResultadoHorizonteRodante res;
+    res.plan.redimensionar(k, T);
+    fill(res.plan.acciones.begin(), res.plan.acciones.end(), 0);
+
+    MotorEvaluacion motor(inst);
+    EstadoSimulacion estado;
+    bool hay_estado = false;
+    Individuo anterior;             // mejor plan de la ventana anterior
+    int desplazamiento = 0;         // ticks de anterior ya fijados
+    GeneradorRng semillas(semilla);
+    // Si quedan más ticks que la ventana, se fijan a lo sumo S y se dejan al menos 3 (el cruce lo requiere)
+    auto avanceVentana = [&](int inicio) {
+        return (T - inicio <= W) ? T - inicio : min(S, T - inicio - 3);
+    };
+    int total_ventanas = 0;
+    for (int inicio = 0; inicio < T; inicio += avanceVentana(inicio)) total_ventanas++;
+    int paso_progreso = max(1, total_ventanas / 10);
+
+    for (int inicio = 0; inicio < T; ) {
+        int w = min(W, T - inicio);
+        int avance = avanceVentana(inicio);
+
+        unique_ptr<AlgoritmoEvolutivo> ae = crear_ae(w, static_cast<uint32_t>(semillas()));
+        ae->generacion = res.generaciones;
+        ae->fijarEstadoInicial(hay_estado ? &estado : nullptr);
+        ae->inicializarPoblacion();
+        if (hay_estado) {
+            Individuo resto;
+            resto.redimensionar(k, w);
+            int n = min(w, anterior.ticks - desplazamiento);
+            for (int d = 0; d < k; ++d) {
+                memcpy(resto.plan(d), anterior.plan(d) + desplazamiento, n);
+                memset(resto.plan(d) + n, 0, w - n);
+            }
+            ae->sembrarIndividuo(resto);
+        }
+
+        ControlParada parada(criterio);
+        long evaluaciones_previas = 0;
+        while (parada.continuar(ae->getMejorIndividuo().fitness,
+                                ae->evaluacionesTotales() - evaluaciones_previas)) {
+            evaluaciones_previas = ae->evaluacionesTotales();
+            ae->ejecutarGeneracion();
+        }
+        res.ventanas++;
+        res.generaciones += parada.generaciones();
+        res.evaluaciones += ae->evaluacionesTotales();
+        res.consultas_cache += ae->consultas_cache;
+        res.aciertos_cache += ae->aciertos_cache;
+        res.motivo = parada.motivo();
+
+        // Fijar el tramo inicial del mejor plan y avanzar el estado hasta su final
+        anterior = ae->getMejorIndividuo();
+        double fitness_ventana = anterior.fitness;
+        if (inicio == 0) res.plan.base_ids = anterior.base_ids;
+        for (int d = 0; d < k; ++d) {
+            memcpy(res.plan.plan(d) + inicio, anterior.plan(d), avance);
+        }
+        motor.fijarEstadoInicial(hay_estado ? &estado : nullptr);
+        EstadoSimulacion siguiente;
+        bool valido = motor.avanzarEstado(anterior, avance, siguiente);
+        estado = move(siguiente);
+        hay_estado = true;
+        desplazamiento = avance;
+
+        if (res.ventanas % paso_progreso == 0 || inicio + avance >= T || !valido) {
+            cout << "Ventana " << res.ventanas << "/" << total_ventanas
+                 << " [" << inicio << ", " << inicio + w << ") - Mejor fitness de la ventana: "
+                 << fitness_ventana << endl;
+        }
+        inicio += avance;
+        if (!valido) {
+            cout << "El tramo fijado de la ventana " << res.ventanas
+                 << " es inválido; se detiene el horizonte rodante" << endl;
+            break;
+        }
+    }
+
+    motor.fijarEstadoInicial(nullptr);
+    motor.evaluar(res.plan, T);
+    res.evaluaciones += motor.evaluacionesRealizadas();
+    return res;
+}
+
+// Probabilidad de que un hijo del modo multiobjetivo active o desactive un dron
+const double PROB_CAMBIO_DRONES = 0.1;
+
+/*
+ * SolucionMO
+ * Individuo del modo multiobjetivo: plan para el máximo de drones del que
+ * vuelan solo los primeros `activos`. Las acciones de los inactivos se
+ * siguen cruzando y mutando sin evaluarse, y un descendiente puede volver a
+ * activarlos. fitness y es_valido del plan son los del plan recortado.
+ */
+struct SolucionMO {
+    Individuo plan;
+    int activos = 1;
+    int rango = 0;                  // frente de no dominación (0 = frente de Pareto)
+    double hacinamiento = 0.0;      // distancia de hacinamiento dentro del frente
+};
+
+/*
+ * dominaMO
+ * - Recibe: plan y drones activos de dos soluciones evaluadas
+ * Dominancia con restricciones: una solución válida domina a toda inválida;
+ * entre inválidas domina la de menor fitness penalizado, y entre válidas la
+ * que no es peor en urgencia ni en drones y es mejor en alguno de los dos.
+ * - Retorna: true si a domina a b
+ */
+bool dominaMO(const Individuo& a, int activos_a, const Individuo& b, int activos_b) {
+    if (a.es_valido != b.es_valido) return a.es_valido;
+    if (!a.es_valido) return a.fitness < b.fitness;
+    return a.fitness <= b.fitness && activos_a <= activos_b &&
+           (a.fitness < b.fitness || activos_a < activos_b);
+}
+
+/*
+ * AlgoritmoMultiobjetivo
+ * NSGA-II con dos objetivos a minimizar: urgencia acumulada y drones activos
+ * (de 1 a k_max). Cruce, mutación, reparación, generadores, motores e hilos
+ * son los de un AlgoritmoEvolutivo interno con k_max drones. Cada generación
+ * produce N hijos, ordena por frentes de no dominación a padres e hijos (2N)
+ * y conserva los N mejores por frente y, en el último que entra, por
+ * distancia de hacinamiento. Con dos objetivos el ordenamiento es
+ * O(N log N): ordenadas por urgencia, cada solución va al primer frente cuyo
+ * mínimo de drones supera el suyo (búsqueda binaria), así que poblaciones de
+ * miles de individuos siguen siendo prácticas. El archivo guarda la mejor
+ * solución encontrada para cada número de drones; sus elementos no dominados
+ * forman el frente de Pareto.
+ */
+class AlgoritmoMultiobjetivo {
+public:
+    AlgoritmoEvolutivo operadores;      // operadores genéticos, motores e hilos
+    int tam_poblacion;
+    int k_max;
+    int T_ticks;
+    vector<SolucionMO> soluciones;      // [0, N) población, [N, 2N) hijos
+    vector<Individuo> recortes_hilo;    // plan recortado a los drones activos, por trabajador
+    vector<Individuo> archivo;          // mejor plan con m drones en archivo[m - 1]
+    vector<char> en_archivo;
+    vector<int> orden;                  // índices ordenados por (validez, urgencia, drones)
+    vector<int> miembros;               // índices agrupados por frente, en el orden anterior
+    vector<int> inicio_frente;          // desplazamiento de cada frente en miembros
+    vector<int> minimos_frente;         // menor número de drones de cada frente válido
+    vector<int> cursor_frente;          // próxima posición libre de cada frente al agrupar
+    vector<char> sobrevive;
+    int generacion;
+    double tiempo_ordenamiento_s;       // tiempo acumulado en clasificar (benchmark)
+
+    /*
+     * Constructor
+     * - Recibe: tamaño de población N, tasa de mutación, máximo de drones,
+     *   horizonte T, instancia, semilla maestra y número de hilos
+     * Lanza runtime_error si el máximo de drones es menor que 1.
+     */
+    AlgoritmoMultiobjetivo(int pop_size, double mut_rate, int k, int T, const Instancia& inst,
+                           uint32_t semilla = 0, int hilos = 1)
+        : operadores(0, mut_rate, k, T, inst, semilla, hilos),
+          tam_poblacion(max(2, pop_size)), k_max(k), T_ticks(T),
+          soluciones(2 * tam_poblacion), recortes_hilo(max(1, hilos)), archivo(k),
+          en_archivo(k, 0), sobrevive(2 * tam_poblacion), generacion(0),
+          tiempo_ordenamiento_s(0.0) {
+        if (k_max < 1) throw runtime_error("el modo multiobjetivo necesita al menos 1 dron");
+    }
+
+    /*
+     * inicializarPoblacion
+     * - Recibe: nada
+     * Genera N planes aleatorios con 1..k_max drones activos en ciclo (cada
+     * cantidad queda representada si N >= k_max), los evalúa y los clasifica.
+     * - Retorna: void
+     */
+    void inicializarPoblacion() {
+        operadores.repartir(0, tam_poblacion, [&](int desde, int hasta, int w) {
+            for (int i = desde; i < hasta; ++i) {
+                SolucionMO& s = soluciones[i];
+                s.plan.inicializarAleatorio(k_max, T_ticks, operadores.inst, operadores.generadores[w]);
+                s.activos = 1 + i % k_max;
+                evaluarSolucion(s, w);
+            }
+        });
+        actualizarArchivo(0, tam_poblacion);
+        clasificar(tam_poblacion);
+    }
+
+    /*
+     * ejecutarGeneracion
+     * - Recibe: nada
+     * Produce N hijos (torneo por frente y hacinamiento, cruce de un punto,
+     * cambio de drones activos, mutación, reparación y evaluación) y se queda
+     * con los N mejores de padres e hijos.
+     * - Retorna: void
+     */
+    void ejecutarGeneracion() {
+        operadores.repartir(tam_poblacion, 2 * tam_poblacion, [&](int desde, int hasta, int w) {
+            GeneradorRng& gen = operadores.generadores[w];
+            uniform_real_distribution<double> dist_cambio(0.0, 1.0);
+            for (int i = desde; i < hasta; ++i) {
+                const SolucionMO& p1 = seleccionarPorTorneo(gen);
+                const SolucionMO& p2 = seleccionarPorTorneo(gen);
+                SolucionMO& hijo = soluciones[i];
+                operadores.cruzarUnPunto(p1.plan, p2.plan, gen, hijo.plan);
+                hijo.activos = p1.activos;
+                if (dist_cambio(gen) < PROB_CAMBIO_DRONES) {
+                    hijo.activos += (gen() & 1) ? 1 : -1;
+                    hijo.activos = max(1, min(k_max, hijo.activos));
+                }
+                operadores.mutar(hijo.plan, gen);
+                evaluarSolucion(hijo, w);
+            }
+        });
+        actualizarArchivo(tam_poblacion, 2 * tam_poblacion);
+        clasificar(2 * tam_poblacion);
+        seleccionarSobrevivientes();
+        generacion++;
+    }
+
+    /*
+     * frentePareto
+     * - Recibe: nada
+     * - Retorna: planes no dominados del archivo (recortados a sus drones
+     *   activos), ordenados por número de drones
+     */
+    vector<const Individuo*> frentePareto() const {
+        vector<const Individuo*> frente;
+        for (int m = 0; m < k_max; ++m) {
+            if (!en_archivo[m]) continue;
+            bool dominado = false;
+            for (int o = 0; o < k_max && !dominado; ++o) {
+                dominado = en_archivo[o] && dominaMO(archivo[o], o + 1, archivo[m], m + 1);
+            }
+            if (!dominado) frente.push_back(&archivo[m]);
+        }
+        return frente;
+    }
+
+    /*
+     * indicadorFrente
+     * - Recibe: nada
+     * Resume el archivo en un escalar que baja cuando mejora la solución de
+     * algún número de drones (para los criterios de parada).
+     * - Retorna: suma de los fitness del archivo
+     */
+    double indicadorFrente() const {
+        double suma = 0.0;
+        for (int m = 0; m < k_max; ++m) {
+            if (en_archivo[m]) suma += archivo[m].fitness;
+        }
+        return suma;
+    }
+
+    /*
+     * evaluacionesTotales
+     * - Recibe: nada
+     * - Retorna: número de soluciones evaluadas
+     */
+    long evaluacionesTotales() const {
+        return operadores.evaluacionesTotales();
+    }
+
+private:
+    /*
+     * evaluarSolucion
+     * - Recibe: solución, índice del trabajador
+     * Copia los drones activos al plan recortado del trabajador, lo repara,
+     * devuelve las acciones reparadas a la solución y lo evalúa.
+     * - Retorna: void (modifica plan, fitness y es_valido de la solución)
+     */
+    void evaluarSolucion(SolucionMO& s, int w) {
+        Individuo& recorte = recortes_hilo[w];
+        size_t genes = static_cast<size_t>(s.activos) * T_ticks;
+        recorte.redimensionar(s.activos, T_ticks);
+        copy(s.plan.base_ids.begin(), s.plan.base_ids.begin() + s.activos, recorte.base_ids.begin());
+        memcpy(recorte.acciones.data(), s.plan.acciones.data(), genes);
+        operadores.repararIndividuo(recorte, w);
+        memcpy(s.plan.acciones.data(), recorte.acciones.data(), genes);
+        operadores.motores[w].evaluar(recorte, T_ticks);
+        s.plan.fitness = recorte.fitness;
+        s.plan.es_valido = recorte.es_valido;
+    }
+
+    /*
+     * actualizarArchivo
+     * - Recibe: rango [desde, hasta) de soluciones recién evaluadas
+     * Reemplaza la entrada de cada número de drones si la solución es mejor
+     * (válida frente a inválida o, si no, de menor fitness).
+     * - Retorna: void
+     */
+    void actualizarArchivo(int desde, int hasta) {
+        for (int i = desde; i < hasta; ++i) {
+            const SolucionMO& s = soluciones[i];
+            int m = s.activos - 1;
+            Individuo& entrada = archivo[m];
+            if (en_archivo[m] && (entrada.es_valido > s.plan.es_valido ||
+                                  (entrada.es_valido == s.plan.es_valido && entrada.fitness <= s.plan.fitness))) {
+                continue;
+            }
+            entrada.redimensionar(s.activos, T_ticks);
+            copy(s.plan.base_ids.begin(), s.plan.base_ids.begin() + s.activos, entrada.base_ids.begin());
+            memcpy(entrada.acciones.data(), s.plan.acciones.data(), static_cast<size_t>(s.activos) * T_ticks);
+            entrada.fitness = s.plan.fitness;
+            entrada.es_valido = s.plan.es_valido;
+            en_archivo[m] = 1;
+        }
+    }
+
+    /*
+     * clasificar
+     * - Recibe: número n de soluciones a clasificar (prefijo de soluciones)
+     * Asigna rango y hacinamiento. Ordena por (validez, urgencia, drones) y
+     * recorre una vez: una válida va al primer frente cuyo mínimo de drones
+     * supera el suyo (los frentes anteriores tienen una solución con urgencia
+     * y drones no mayores, que la domina); las inválidas forman un frente por
+     * cada fitness penalizado distinto, después de los válidos; objetivos
+     * idénticos comparten frente. Dentro de un frente el orden por urgencia
+     * es el inverso del orden por drones, así que el hacinamiento se calcula
+     * con los vecinos en ese mismo orden.
+     * - Retorna: void
+     */
+    void clasificar(int n) {
+        auto t0 = chrono::steady_clock::now();
+        orden.resize(n);
+        iota(orden.begin(), orden.end(), 0);
+        sort(orden.begin(), orden.end(), [&](int a, int b) {
+            const SolucionMO& x = soluciones[a];
+            const SolucionMO& y = soluciones[b];
+            if (x.plan.es_valido != y.plan.es_valido) return x.plan.es_valido > y.plan.es_valido;
+            if (x.plan.fitness != y.plan.fitness) return x.plan.fitness < y.plan.fitness;
+            return x.activos < y.activos;
+        });
+        
+        minimos_frente.clear();
+        int num_frentes = 0;
+        for (int i = 0; i < n; ++i) {
+            SolucionMO& s = soluciones[orden[i]];
+            const SolucionMO* previa = i > 0 ? &soluciones[orden[i - 1]] : nullptr;
+            if (previa && previa->plan.es_valido == s.plan.es_valido && previa->plan.fitness == s.plan.fitness &&
+                (!s.plan.es_valido || previa->activos == s.activos)) {
+                s.rango = previa->rango;
+            } else if (s.plan.es_valido) {
+                auto it = upper_bound(minimos_frente.begin(), minimos_frente.end(), s.activos);
+                s.rango = it - minimos_frente.begin();
+                if (it == minimos_frente.end()) {
+                    minimos_frente.push_back(s.activos);
+                } else {
+                    *it = s.activos;
+                }
+            } else {
+                s.rango = (previa && !previa->plan.es_valido) ? previa->rango + 1
+                                                              : static_cast<int>(minimos_frente.size());
+            }
+            num_frentes = max(num_frentes, s.rango + 1);
+        }
+        
+        // Agrupar por frente conservando el orden (conteo estable)
+        inicio_frente.assign(num_frentes + 1, 0);
+        for (int i = 0; i < n; ++i) inicio_frente[soluciones[i].rango + 1]++;
+        for (int f = 0; f < num_frentes; ++f) inicio_frente[f + 1] += inicio_frente[f];
+        miembros.resize(n);
+        cursor_frente.assign(inicio_frente.begin(), inicio_frente.end() - 1);
+        for (int i : orden) miembros[cursor_frente[soluciones[i].rango]++] = i;
+        
+        // Distancia de hacinamiento: extremos infinitos, interiores según sus vecinos
+        const double infinito = numeric_limits<double>::infinity();
+        for (int f = 0; f < num_frentes; ++f) {
+            const int* m = &miembros[inicio_frente[f]];
+            int tam = inicio_frente[f + 1] - inicio_frente[f];
+            const SolucionMO& primera = soluciones[m[0]];
+            const SolucionMO& ultima = soluciones[m[tam - 1]];
+            double rango_urgencia = ultima.plan.fitness - primera.plan.fitness;
+            double rango_drones = abs(primera.activos - ultima.activos);
+            soluciones[m[0]].hacinamiento = infinito;
+            soluciones[m[tam - 1]].hacinamiento = infinito;
+            for (int j = 1; j + 1 < tam; ++j) {
+                const SolucionMO& antes = soluciones[m[j - 1]];
+                const SolucionMO& despues = soluciones[m[j + 1]];
+                double d = 0.0;
+                if (rango_urgencia > 0) d += (despues.plan.fitness - antes.plan.fitness) / rango_urgencia;
+                if (rango_drones > 0) d += abs(antes.activos - despues.activos) / rango_drones;
+                soluciones[m[j]].hacinamiento = d;
+            }
+        }
+        tiempo_ordenamiento_s += chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    }
+
+    /*
+     * seleccionarSobrevivientes
+     * - Recibe: nada (usa la clasificación de las 2N soluciones)
+     * Toma frentes completos mientras quepan y del siguiente los de mayor
+     * hacinamiento; luego intercambia los elegidos de la mitad de hijos con
+     * los descartados de la población, sin copiar planes.
+     * - Retorna: void
+     */
+    void seleccionarSobrevivientes() {
+        fill(sobrevive.begin(), sobrevive.end(), 0);
+        int elegidos = 0;
+        for (size_t f = 0; f + 1 < inicio_frente.size() && elegidos < tam_poblacion; ++f) {
+            int* m = &miembros[inicio_frente[f]];
+            int tam = inicio_frente[f + 1] - inicio_frente[f];
+            int faltan = tam_poblacion - elegidos;
+            if (tam > faltan) {
+                nth_element(m, m + faltan, m + tam, [&](int a, int b) {
+                    return soluciones[a].hacinamiento > soluciones[b].hacinamiento;
+                });
+                tam = faltan;
+            }
+            for (int j = 0; j < tam; ++j) sobrevive[m[j]] = 1;
+            elegidos += tam;
+        }
+        
+        int j = tam_poblacion;
+        for (int i = 0; i < tam_poblacion; ++i) {
+            if (sobrevive[i]) continue;
+            while (!sobrevive[j]) j++;
+            swap(soluciones[i], soluciones[j++]);
+        }
+    }
+
+    /*
+     * seleccionarPorTorneo
+     * - Recibe: generador del trabajador
+     * Torneo de operadores.tam_torneo participantes: gana el de menor rango
+     * y, a igual rango, el de mayor hacinamiento.
+     * - Retorna: referencia a la solución ganadora
+     */
+    const SolucionMO& seleccionarPorTorneo(GeneradorRng& gen) const {
+        uniform_int_distribution<int> dist_pop(0, tam_poblacion - 1);
+        const SolucionMO* mejor = &soluciones[dist_pop(gen)];
+        for (int i = 1; i < operadores.tam_torneo; ++i) {
+            const SolucionMO* retador = &soluciones[dist_pop(gen)];
+            if (retador->rango < mejor->rango ||
+                (retador->rango == mejor->rango && retador->hacinamiento > mejor->hacinamiento)) {
+                mejor = retador;
+            }
+        }
+        return *mejor;
+    }
+};
+
+/*
+ * abrirCSVAcumulativo
+ * - Recibe: ruta del archivo, línea de encabezado (sin salto de línea)
+ * Abre el CSV en modo append. Si el archivo no existe escribe el encabezado;
+ * si existe con otro encabezado (versión anterior del formato) lo renombra a
+ * <ruta>.anterior y empieza uno nuevo, para no mezclar columnas.
+ * - Retorna: flujo abierto listo para agregar filas
+ */
+ofstream abrirCSVAcumulativo(const string& ruta, const string& encabezado) {
+    string primera_linea;
+    bool existe = false;
+    {
+        ifstream previo(ruta);
+        existe = previo.good() && getline(previo, primera_linea);
+    }
+    if (existe && primera_linea != encabezado) {
+        string respaldo = ruta + ".anterior";
+        rename(ruta.c_str(), respaldo.c_str());
+        cerr << "Aviso: " << ruta << " tenía otro formato; se movió a " << respaldo << endl;
+        existe = false;
+    }
+    
+    ofstream archivo(ruta, ios::app);  // Modo append
+    if (!existe) {
+        archivo << encabezado << "\n";
+    }
+    return archivo;
+}
+
+/*
+ * guardarResultadosCSV
+ * - Recibe: nombre instancia, parámetros, mejor individuo, tiempo ejecución,
+ *   semilla maestra y generador usados, generaciones ejecutadas, motivo de parada
+ *   y tasa de aciertos de la caché de fitness (negativa si estaba desactivada)
+ * Guarda estadísticas de ejecución en archivo CSV.
+ * - Retorna: void
+ */
+void guardarResultadosCSV(const string& nombre_instancia, int num_drones, int K_iter, 
+                          int T_ticks, const Individuo& mejor_ind, double tiempo_s,
+                          uint32_t semilla, TipoRng tipo_rng, int generaciones,
+                          MotivoParada motivo, double tasa_cache) {
+    crearDirectorio("resultados");
+    
+    stringstream ss;
+    ss << "resultados/" << nombre_instancia << "_estadisticas.csv";
+    
+    ofstream archivo = abrirCSVAcumulativo(ss.str(),
+        "num_drones,iteraciones,ticks_operacion,urgencia_acumulada,solucion_valida,tiempo_s,semilla,rng,"
+        "generaciones,motivo_parada,tasa_cache");
+    
+    // Agregar fila de datos
+    archivo << num_drones << ","
+            << K_iter << ","
+            << T_ticks << ","
+            << fixed << setprecision(2) << mejor_ind.fitness << ","
+            << (mejor_ind.es_valido ? "Si" : "No") << ","
+            << setprecision(3) << tiempo_s << ","
+            << semilla << ","
+            << nombreRng(tipo_rng) << ","
+            << generaciones << ","
+            << NOMBRES_PARADA[motivo] << ",";
+    if (tasa_cache >= 0) archivo << setprecision(4) << tasa_cache;
+    archivo << "\n";
+    
+    archivo.close();
+    cout << "\nEstadísticas guardadas en: " << ss.str() << endl;
+}
+
+/*
+ * guardarFrenteParetoCSV
+ * - Recibe: nombre instancia, máximo de drones, iteraciones, T, frente de
+ *   Pareto (un plan por número de drones), tiempo de ejecución, semilla y
+ *   generador, generaciones ejecutadas y motivo de parada
+ * Agrega una fila por solución del frente al CSV de Pareto de la instancia.
+ * - Retorna: void
+ */
+void guardarFrenteParetoCSV(const string& nombre_instancia, int max_drones, int K_iter, int T_ticks,
+                            const vector<const Individuo*>& frente, double tiempo_s,
+                            uint32_t semilla, TipoRng tipo_rng, int generaciones, MotivoParada motivo) {
+    crearDirectorio("resultados");
+    
+    string ruta = "resultados/" + nombre_instancia + "_pareto.csv";
+    ofstream archivo = abrirCSVAcumulativo(ruta,
+        "max_drones,drones_activos,iteraciones,ticks_operacion,urgencia_acumulada,solucion_valida,"
+        "tiempo_s,semilla,rng,generaciones,motivo_parada");
+    
+    for (const Individuo* plan : frente) {
+        archivo << max_drones << ","
+                << plan->base_ids.size() << ","
+                << K_iter << ","
+                << T_ticks << ","
+                << fixed << setprecision(2) << plan->fitness << ","
+                << (plan->es_valido ? "Si" : "No") << ","
+                << setprecision(3) << tiempo_s << ","
+                << semilla << ","
+                << nombreRng(tipo_rng) << ","
+                << generaciones << ","
+                << NOMBRES_PARADA[motivo] << "\n";
+    }
+    
+    archivo.close();
+    cout << "\nFrente de Pareto guardado en: " << ruta << endl;
+}
+
+/*
+ * Trayectorias
+ * Posiciones de cada dron en los ticks 0..T de un plan, obtenidas con una
+ * sola simulación y compartidas por la consola y los archivos de rutas.
+ */
+struct Trayectorias {
+    int k;
+    int T;
+    vector<int> base_ids;
+    vector<uint8_t> acciones;          // mismo orden que Individuo::acciones (dron-mayor)
+    vector<Coordenada> posiciones;     // dron d, tick t en d * (T + 1) + t
+
+    const Coordenada& posicion(int d, int t) const {
+        return posiciones[static_cast<size_t>(d) * (T + 1) + t];
+    }
+};
+
+/*
+ * simularTrayectorias
+ * - Recibe: individuo, instancia del problema, horizonte temporal T
+ * Recorre el plan una vez y guarda la posición de cada dron en cada tick.
+ * - Retorna: trayectorias del plan
+ */
+Trayectorias simularTrayectorias(const Individuo& ind, const Instancia& inst, int T) {
+    Trayectorias tray;
+    tray.k = ind.base_ids.size();
+    tray.T = T;
+    tray.base_ids = ind.base_ids;
+    tray.acciones.assign(ind.acciones.begin(), ind.acciones.begin() + static_cast<size_t>(tray.k) * T);
+    tray.posiciones.resize(static_cast<size_t>(tray.k) * (T + 1));
+    for (int d = 0; d < tray.k; ++d) {
+        Coordenada* pos = &tray.posiciones[static_cast<size_t>(d) * (T + 1)];
+        pos[0] = inst.bases[ind.base_ids[d]];
+        for (int t = 0; t < T; ++t) {
+            pos[t + 1] = aplicarAccion(pos[t], ind.accion(d, t));
+        }
+    }
+    return tray;
+}
+
+/*
+ * EscritorBuffer
+ * Escritura secuencial a archivo a través de un buffer grande propio: las
+ * filas se arman en memoria (enteros con to_chars) y se vuelcan con fwrite
+ * en bloques, en lugar de un operator<< por campo.
+ */
+class EscritorBuffer {
+public:
+    explicit EscritorBuffer(const string& ruta, size_t capacidad = 1 << 20)
+        : archivo(fopen(ruta.c_str(), "wb")), buffer(capacidad), usado(0) {
+        if (!archivo) {
+            throw runtime_error("no se pudo crear " + ruta);
+        }
+    }
+
+    ~EscritorBuffer() {
+        cerrar();
+    }
+
+    EscritorBuffer(const EscritorBuffer&) = delete;
+    EscritorBuffer& operator=(const EscritorBuffer&) = delete;
+
+    void escribir(const char* datos, size_t n) {
+        if (usado + n > buffer.size()) vaciar();
+        if (n > buffer.size()) {
+            fwrite(datos, 1, n, archivo);
+            return;
+        }
+        memcpy(buffer.data() + usado, datos, n);
+        usado += n;
+    }
+
+    void escribir(const string& texto) {
+        escribir(texto.data(), texto.size());
+    }
+
+    void escribirCaracter(char c) {
+        if (usado == buffer.size()) vaciar();
+        buffer[usado++] = c;
+    }
+
+    void escribirEntero(long valor) {
+        char digitos[24];
+        to_chars_result r = to_chars(digitos, digitos + sizeof(digitos), valor);
+        escribir(digitos, r.ptr - digitos);
+    }
+
+    template <typename T>
+    void escribirBinario(const T& valor) {
+        escribir(reinterpret_cast<const char*>(&valor), sizeof(T));
+    }
+
+    /*
+     * cerrar
+     * - Recibe: nada
+     * Vuelca lo pendiente y cierra el archivo (también lo hace el destructor).
+     * - Retorna: void (lanza runtime_error si la escritura falló)
+     */
+    void cerrar() {
+        if (!archivo) return;
+        vaciar();
+        bool error = ferror(archivo);
+        error = (fclose(archivo) != 0) || error;
+        archivo = nullptr;
+        if (error) {
+            throw runtime_error("error al escribir el archivo de salida");
+        }
+    }
+
+private:
+    FILE* archivo;
+    vector<char> buffer;
+    size_t usado;
+
+    void vaciar() {
+        if (usado > 0) fwrite(buffer.data(), 1, usado, archivo);
+        usado = 0;
+    }
+};
+
+// Formatos de archivo para las rutas de la mejor solución
+enum FormatoRutas {
+    RUTAS_CSV,
+    RUTAS_BINARIO,
+    RUTAS_NINGUNO
+};
+
+/*
+ * reemplazarArchivo
+ * - Recibe: archivo temporal ya escrito y cerrado, ruta definitiva
+ * Renombra el temporal sobre la ruta definitiva; si falla borra el temporal
+ * y deja el archivo anterior como estaba.
+ * - Retorna: void (lanza runtime_error si no se pudo reemplazar)
+ */
+void reemplazarArchivo(const string& temporal, const string& ruta) {
+    if (rename(temporal.c_str(), ruta.c_str()) != 0) {
+        string causa = strerror(errno);
+        remove(temporal.c_str());
+        throw runtime_error("no se pudo reemplazar " + ruta + ": " + causa);
+    }
+}
+
+// Firma y versión del archivo binario de rutas
+const char FIRMA_RUTAS_BINARIAS[8] = {'P', 'S', 'P', 'R', 'U', 'T', 'A', '\0'};
+const uint32_t VERSION_RUTAS_BINARIAS = 1;
+
+/*
+ * guardarRutasCSV
+ * - Recibe: nombre instancia, trayectorias de la mejor solución
+ * Guarda las rutas de cada dron en formato CSV para visualización. El archivo
+ * conserva una ejecución por número de drones: las filas anteriores con el
+ * mismo num_drones se reemplazan, así no crece sin límite entre ejecuciones.
+ * Se escribe en un archivo temporal con EscritorBuffer y luego se renombra.
+ * - Retorna: void (lanza runtime_error si no se pudo escribir o reemplazar)
+ */
+void guardarRutasCSV(const string& nombre_instancia, const Trayectorias& tray) {
+    crearDirectorio("resultados");
+    
+    string ruta = "resultados/" + nombre_instancia + "_rutas.csv";
+    string temporal = ruta + ".tmp";
+    const string encabezado = "num_drones,dron,tick,fila,columna,accion,base_origen";
+    
+    EscritorBuffer archivo(temporal);
+    archivo.escribir(encabezado);
+    archivo.escribirCaracter('\n');
+    
+    // Conservar las filas de otras cantidades de drones
+    {
+        ifstream previo(ruta);
+        string linea;
+        if (getline(previo, linea) && linea == encabezado) {
+            string prefijo = to_string(tray.k) + ",";
+            while (getline(previo, linea)) {
+                if (linea.compare(0, prefijo.size(), prefijo) == 0) continue;
+                archivo.escribir(linea);
+                archivo.escribirCaracter('\n');
+            }
+        }
+    }
+    
+    for (int t = 0; t <= tray.T; ++t) {
+        for (int d = 0; d < tray.k; ++d) {
+            const Coordenada& pos = tray.posicion(d, t);
+            archivo.escribirEntero(tray.k);
+            archivo.escribirCaracter(',');
+            archivo.escribirEntero(d);
+            archivo.escribirCaracter(',');
+            archivo.escribirEntero(t);
+            archivo.escribirCaracter(',');
+            archivo.escribirEntero(pos.fila);
+            archivo.escribirCaracter(',');
+            archivo.escribirEntero(pos.col);
+            archivo.escribirCaracter(',');
+            archivo.escribirEntero(t == 0 ? 0 : tray.acciones[static_cast<size_t>(d) * tray.T + t - 1]);
+            archivo.escribirCaracter(',');
+            archivo.escribirEntero(tray.base_ids[d]);
+            archivo.escribirCaracter('\n');
+        }
+    }
+    archivo.cerrar();
+    reemplazarArchivo(temporal, ruta);
+    cout << "Rutas guardadas en: " << ruta << endl;
+}
+
+/*
+ * guardarRutasBinario
+ * - Recibe: nombre instancia, trayectorias de la mejor solución
+ * Guarda las rutas en formato binario compacto: firma PSPRUTA, versión
+ * (uint32) y un registro por número de drones con int32 k, int32 T y, por
+ * dron, int32 base, fila y columna iniciales seguidos de T bytes de acciones.
+ * Cada acción es el desplazamiento respecto del tick anterior, así que las
+ * posiciones se reconstruyen sumando DELTA_FILA/DELTA_COL desde la base.
+ * Como en el CSV, se reemplaza el registro previo con el mismo k.
+ * - Retorna: void (lanza runtime_error si no se pudo escribir o reemplazar)
+ */
+void guardarRutasBinario(const string& nombre_instancia, const Trayectorias& tray) {
+    crearDirectorio("resultados");
+    
+    string ruta = "resultados/" + nombre_instancia + "_rutas.bin";
+    string temporal = ruta + ".tmp";
+    
+    EscritorBuffer archivo(temporal);
+    archivo.escribir(FIRMA_RUTAS_BINARIAS, sizeof(FIRMA_RUTAS_BINARIAS));
+    archivo.escribirBinario(VERSION_RUTAS_BINARIAS);
+    
+    // Conservar los registros de otras cantidades de drones
+    {
+        ifstream previo(ruta, ios::binary);
+        vector<char> datos((istreambuf_iterator<char>(previo)), istreambuf_iterator<char>());
+        size_t cabecera = sizeof(FIRMA_RUTAS_BINARIAS) + sizeof(uint32_t);
+        uint32_t version = 0;
+        if (datos.size() >= cabecera) memcpy(&version, datos.data() + sizeof(FIRMA_RUTAS_BINARIAS), sizeof(version));
+        if (datos.size() >= cabecera &&
+            memcmp(datos.data(), FIRMA_RUTAS_BINARIAS, sizeof(FIRMA_RUTAS_BINARIAS)) == 0 &&
+            version == VERSION_RUTAS_BINARIAS) {
+            size_t i = cabecera;
+            while (i + 2 * sizeof(int32_t) <= datos.size()) {
+                int32_t k, T;
+                memcpy(&k, datos.data() + i, sizeof(k));
+                memcpy(&T, datos.data() + i + sizeof(k), sizeof(T));
+                size_t largo = 2 * sizeof(int32_t) + static_cast<size_t>(k) * (3 * sizeof(int32_t) + T);
+                if (k < 0 || T < 0 || i + largo > datos.size()) break;
+                if (k != tray.k) archivo.escribir(datos.data() + i, largo);
+                i += largo;
+            }
+        }
+    }
+    
+    archivo.escribirBinario(static_cast<int32_t>(tray.k));
+    archivo.escribirBinario(static_cast<int32_t>(tray.T));
+    for (int d = 0; d < tray.k; ++d) {
+        const Coordenada& inicio = tray.posicion(d, 0);
+        archivo.escribirBinario(static_cast<int32_t>(tray.base_ids[d]));
+        archivo.escribirBinario(static_cast<int32_t>(inicio.fila));
+        archivo.escribirBinario(static_cast<int32_t>(inicio.col));
+        archivo.escribir(reinterpret_cast<const char*>(tray.acciones.data()) + static_cast<size_t>(d) * tray.T,
+                         tray.T);
+    }
+    archivo.cerrar();
+    reemplazarArchivo(temporal, ruta);
+    cout << "Rutas guardadas en: " << ruta << endl;
+}
+
+/*
+ * imprimirMejorRuta
+ * - Recibe: trayectorias de la mejor solución
+ * Muestra las rutas de cada dron en consola armando cada línea en memoria.
+ * - Retorna: void (imprime en consola)
+ */
+void imprimirMejorRuta(const Trayectorias& tray) {
+    // Imprimir formato: D1: B0 - (f,c) - ...
+    string linea;
+    cout << "Rutas:" << endl;
+    for (int d = 0; d < tray.k; ++d) {
+        linea = "D" + to_string(d + 1) + ": B" + to_string(tray.base_ids[d]);
+        for (int t = 1; t <= tray.T; ++t) {
+            const Coordenada& pos = tray.posicion(d, t);
+            linea += " - (";
+            linea += to_string(pos.fila);
+            linea += ',';
+            linea += to_string(pos.col);
+            linea += ')';
+        }
+        linea += '\n';
+        cout << linea;
+    }
+    cout.flush();
+}
+
+/*
+ * compararFitness
+ * - Recibe: resultado de referencia, resultado del motor, contexto del caso y
+ *   tolerancia relativa (0 = comparación bit a bit)
+ * Compara fitness y validez, informando la discrepancia por cerr.
+ * - Retorna: 1 si difieren, 0 si coinciden
+ */
+int compararFitness(const Individuo& ref, const Individuo& ind, const string& ruta,
+                    int k, int T, const string& modo, double tolerancia = 0.0) {
+    bool iguales = (tolerancia == 0.0)
+        ? memcmp(&ref.fitness, &ind.fitness, sizeof(double)) == 0
+        : fabs(ref.fitness - ind.fitness) <= tolerancia * max(1.0, fabs(ref.fitness));
+    if (iguales && ref.es_valido == ind.es_valido) {
+        return 0;
+    }
+    cerr << "Discrepancia (" << modo << ") en " << ruta << " (k=" << k << ", T=" << T
+         << "): referencia=" << setprecision(17) << ref.fitness
+         << " motor=" << ind.fitness << endl;
+    return 1;
+}
+
+/*
+ * verificarKernels
+ * - Recibe: tolerancia relativa
+ * Compara cada kernel de urgencias disponible con el ciclo original de dos
+ * pasadas (sumar y luego incrementar) sobre tasas no enteras y tamaños que
+ * no son múltiplo del ancho vectorial.
+ * - Retorna: número de discrepancias encontradas
+ */
+int verificarKernels(double tolerancia) {
+    GeneradorRng gen(2024);
+    uniform_real_distribution<double> dist(0.0, 100.0);
+    int discrepancias = 0;
+
+    for (const char* nombre : {"escalar", "sse2", "avx2"}) {
+        KernelUrgencia kernel = kernelUrgenciaPorNombre(nombre);
+        if (!kernel) continue;
+        for (int n : {0, 1, 3, 7, 8, 13, 70, 501}) {
+            vector<double> tasas(n), urgencia(n);
+            for (int u = 0; u < n; ++u) {
+                tasas[u] = dist(gen);
+                urgencia[u] = dist(gen) * 10.0;
+            }
+            vector<double> esperado = urgencia;
+            double suma_esperada = 0.0;
+            for (int u = 0; u < n; ++u) suma_esperada += esperado[u];
+            for (int u = 0; u < n; ++u) esperado[u] += tasas[u];
+
+            double suma = kernel(urgencia.data(), tasas.data(), n);
+            bool ok = fabs(suma - suma_esperada) <= tolerancia * max(1.0, fabs(suma_esperada)) &&
+                      urgencia == esperado;
+            if (!ok) {
+                discrepancias++;
+                cerr << "Discrepancia en kernel " << nombre << " (n=" << n << "): esperado="
+                     << setprecision(17) << suma_esperada << " obtenido=" << suma << endl;
+            }
+        }
+    }
+    return discrepancias;
+}
+
+/*
+ * verificarMotor
+ * - Recibe: rutas de archivos de instancia
+ * Prueba de regresión: evalúa planes aleatorios (reparados y sin reparar, con
+ * distintos k y T) con MotorEvaluacion y con calcularFitnessReferencia. Con el
+ * kernel escalar exige fitness y validez idénticos bit a bit; con los kernels
+ * SIMD disponibles, dentro de una tolerancia relativa. También verifica la
+ * evaluación incremental (evaluarDesde) de hijos con la cola modificada, la
+ * evaluación intercalada de todos los planes de cada caso en un solo lote y
+ * el modo perezoso (también con puntos de control y reanudando hijos).
+ * - Retorna: número de discrepancias encontradas (0 = OK)
+ */
+int verificarMotor(const vector<string>& rutas) {
+    const int ks[] = {1, 3, 5, 10};
+    const int Ts[] = {1, 10, 50, 120};
+    const int planes_por_caso = 40;
+    const double tolerancia_simd = 1e-12;
+    int discrepancias = verificarKernels(tolerancia_simd);
+    GeneradorRng rng(2024);
+
+    vector<string> kernels;
+    for (const char* nombre : {"escalar", "sse2", "avx2"}) {
+        if (kernelUrgenciaPorNombre(nombre)) kernels.push_back(nombre);
+    }
+
+    for (const string& ruta : rutas) {
+        Instancia inst(ruta);
+        MotorEvaluacion motor(inst);
+        MotorEvaluacion motor_controles(inst, 7);
+        MotorEvaluacion motor_perezoso(inst);
+        MotorEvaluacion motor_perezoso_controles(inst, 7);
+        motor_perezoso.usarEvaluacionPerezosa(true);
+        motor_perezoso_controles.usarEvaluacionPerezosa(true);
+        int evaluados = 0;
+        int validos = 0;
+
+        for (int k : ks) {
+            for (int T : Ts) {
+                AlgoritmoEvolutivo ae(0, 0.0, k, T, inst);
+                vector<Individuo> lote(planes_por_caso);
+                vector<Individuo> lote_ref(planes_por_caso);
+                for (int i = 0; i < planes_por_caso; ++i) {
+                    Individuo ind;
+                    ind.inicializarAleatorio(k, T, inst, rng);
+                    if (i % 4 != 0) ae.repararIndividuo(ind);
+
+                    Individuo ref = ind;
+                    calcularFitnessReferencia(ref, inst, T);
+                    lote[i] = ind;
+                    lote_ref[i] = ref;
+                    evaluados++;
+                    if (ref.es_valido) validos++;
+                    for (const string& nombre : kernels) {
+                        Individuo copia = ind;
+                        motor.usarKernel(kernelUrgenciaPorNombre(nombre));
+                        calcularFitness(copia, motor, T);
+                        discrepancias += compararFitness(ref, copia, ruta, k, T, "kernel " + nombre,
+                                                         nombre == "escalar" ? 0.0 : tolerancia_simd);
+                    }
+
+                    Individuo perezoso = ind;
+                    motor_perezoso.evaluar(perezoso, T);
+                    discrepancias += compararFitness(ref, perezoso, ruta, k, T, "perezoso");
+
+                    // Hijo con la cola modificada desde un tick aleatorio
+                    Individuo padre = ind;
+                    motor_controles.evaluar(padre, T);
+                    discrepancias += compararFitness(ref, padre, ruta, k, T, "con controles");
+                    Individuo padre_perezoso = ind;
+                    motor_perezoso_controles.evaluar(padre_perezoso, T);
+
+                    Individuo hijo = padre;
+                    int corte = uniform_int_distribution<int>(0, T - 1)(rng);
+                    for (int d = 0; d < k; ++d) {
+                        for (int t = corte; t < T; ++t) {
+                            hijo.accion(d, t) = uniform_int_distribution<int>(0, 8)(rng);
+                        }
+                    }
+                    if (i % 4 != 0) ae.repararIndividuo(hijo);
+                    Individuo ref_hijo = hijo;
+                    calcularFitnessReferencia(ref_hijo, inst, T);
+                    Individuo hijo_perezoso = hijo;
+                    motor_controles.evaluarDesde(hijo, padre, primerTickModificado(hijo, padre, T), T);
+                    discrepancias += compararFitness(ref_hijo, hijo, ruta, k, T, "incremental");
+                    motor_perezoso_controles.evaluarDesde(hijo_perezoso, padre_perezoso,
+                                                          primerTickModificado(hijo_perezoso, padre_perezoso, T), T);
+                    discrepancias += compararFitness(ref_hijo, hijo_perezoso, ruta, k, T,
+                                                     "incremental perezoso");
+                }
+
+                // Todos los planes del caso evaluados intercalados en un lote
+                vector<TareaEvaluacion> tareas;
+                for (Individuo& ind : lote) tareas.push_back({&ind, nullptr, 0});
+                motor.usarKernel(kernel_urgencia_defecto);
+                motor.evaluarLote(tareas.data(), tareas.size(), T);
+                for (int i = 0; i < planes_por_caso; ++i) {
+                    discrepancias += compararFitness(lote_ref[i], lote[i], ruta, k, T, "lote",
+                                                     tolerancia_simd);
+                }
+            }
+        }
+        cout << "Verificado " << ruta << ": " << evaluados << " planes ("
+             << validos << " válidos), kernels:";
+        for (const string& nombre : kernels) cout << " " << nombre;
+        cout << endl;
+    }
+
+    cout << (discrepancias == 0 ? "OK: " : "FALLO: ") << discrepancias
+         << " discrepancias" << endl;
+    return discrepancias;
+}
+
+/*
+ * ConfigAE
+ * Combinación de parámetros del algoritmo evolutivo probada en un barrido.
+ */
+struct ConfigAE {
+    string nombre;
+    int poblacion;
+    double mutacion;
+    int torneo;
+};
+
+/*
+ * ConfigBarrido
+ * Contenido de un archivo de configuración de barrido: el producto
+ * instancias × drones × ticks × configuraciones × repeticiones define las
+ * ejecuciones independientes del barrido.
+ */
+struct ConfigBarrido {
+    vector<string> instancias;
+    vector<int> drones;
+    vector<int> ticks;
+    vector<ConfigAE> configuraciones;
+    int iteraciones = 1000;
+    CriterioParada criterio;       // límites adicionales (tiempo, evaluaciones, estancamiento)
+    int repeticiones = 1;
+    int elite = 1;
+    int intervalo_memetico = 0;    // 0 = sin búsqueda local
+    int top_memetico = 2;
+    int pasos_memetico = 20;
+    size_t entradas_cache = 0;     // 0 = sin caché de fitness
+    uint32_t semilla = 0;
+    TipoRng tipo_rng = RNG_MT19937;
+};
+
+/*
+ * EjecucionBarrido
+ * Una ejecución del barrido (índices a la configuración) y su resultado.
+ */
+struct EjecucionBarrido {
+    int instancia;
+    int k;
+    int T;
+    int config;
+    int repeticion;
+    uint32_t semilla;
+    double fitness;
+    bool valido;
+    double tiempo_s;
+    long evaluaciones;
+    int generaciones;
+    MotivoParada motivo;
+    double tasa_cache;          // negativa sin caché
+};
+
+// Entradas máximas de la caché de fitness (--cache, CACHE): 2^26 entradas ocupan 1,5 GB
+const size_t MAX_ENTRADAS_CACHE = size_t(1) << 26;
+
+/*
+ * ParametrosEjecucion
+ * Parámetros de una ejecución del AE que se validan igual en la línea de
+ * comandos y en cada combinación de un barrido (ver parametrosValidos).
+ */
+struct ParametrosEjecucion {
+    int k;
+    int T;
+    int iteraciones;
+    int poblacion;
+    double mutacion;
+    int torneo;
+    int elite;
+    CriterioParada criterio;
+    int intervalo_memetico;
+    int top_memetico;
+    int pasos_memetico;
+    size_t entradas_cache;
+};
+
+/*
+ * parametrosValidos
+ * - Recibe: parámetros de la ejecución, prefijo de los mensajes
+ * El cruce de un punto elige el corte en [1, T-2], así que T debe ser al
+ * menos 3; la población necesita al menos dos individuos y el torneo y la
+ * élite entre 1 y la población; sin límite de iteraciones hace falta otro
+ * criterio de parada para que la ejecución termine.
+ * - Retorna: true si son válidos (si no, informa el primer error por cerr)
+ */
+bool parametrosValidos(const ParametrosEjecucion& p, const string& origen) {
+    auto error = [&origen](const string& detalle) {
+        cerr << "Error: " << origen << detalle << endl;
+        return false;
+    };
+    const CriterioParada& c = p.criterio;
+    if (p.k < 0) return error("el número de drones no puede ser negativo (" + to_string(p.k) + ")");
+    if (p.T < 3) return error("T_ticks debe ser al menos 3 (" + to_string(p.T) + ")");
+    if (p.poblacion < 2) {
+        return error("la población debe tener al menos 2 individuos (" + to_string(p.poblacion) + ")");
+    }
+    if (p.torneo < 1 || p.torneo > p.poblacion) {
+        return error("el torneo debe estar entre 1 y la población (" + to_string(p.torneo) + ")");
+    }
+    if (p.elite < 1 || p.elite > p.poblacion) {
+        return error("la élite debe estar entre 1 y la población (" + to_string(p.elite) + ")");
+    }
+    if (!(p.mutacion >= 0.0 && p.mutacion <= 1.0)) {
+        return error("la tasa de mutación debe estar entre 0 y 1 (" + to_string(p.mutacion) + ")");
+    }
+    if (p.iteraciones < 0 || c.tiempo_max_s < 0 || c.max_evaluaciones < 0 || c.estancamiento < 0 ||
+        c.epsilon < 0) {
+        return error("las iteraciones y los criterios de parada no pueden ser negativos");
+    }
+    if (p.iteraciones == 0 && c.tiempo_max_s <= 0 && c.max_evaluaciones <= 0 && c.estancamiento <= 0) {
+        return error("K_iteraciones = 0 (sin límite) requiere un límite de tiempo, de evaluaciones o de estancamiento");
+    }
+    if (p.intervalo_memetico < 0 || (p.intervalo_memetico > 0 && (p.top_memetico < 1 || p.pasos_memetico < 1))) {
+        return error("la etapa memética necesita intervalo >= 0, top >= 1 y pasos >= 1");
+    }
+    if (p.intervalo_memetico > 0 && p.k < 1) {
+        return error("la etapa memética necesita al menos 1 dron");
+    }
+    if (p.entradas_cache > MAX_ENTRADAS_CACHE) {
+        return error("la caché admite a lo sumo " + to_string(MAX_ENTRADAS_CACHE) + " entradas");
+    }
+    return true;
+}
+
+/*
+ * cargarConfiguracionBarrido
+ * - Recibe: ruta del archivo, configuración a llenar
+ * Lee un archivo de líneas "CLAVE valores..." (el texto tras '#' se ignora):
+ *   INSTANCIAS <ruta>...   DRONES <k>...   TICKS <T>...   ITERACIONES <n>
+ *   REPETICIONES <n>   ELITE <n>   SEMILLA <s>   RNG mt19937|xoshiro
+ *   TIEMPO_MAX <s>   MAX_EVALUACIONES <n>   ESTANCAMIENTO <n> [epsilon]
+ *   MEMETICO <generaciones> <top> <pasos>   CACHE <entradas>
+ *   CONFIG <nombre> <poblacion> <mutacion> <torneo>   (una por línea)
+ * Sin líneas CONFIG se usa la configuración por defecto (150, 0.05, 5).
+ * - Retorna: true si el archivo es válido (si no, informa el error por cerr)
+ */
+bool cargarConfiguracionBarrido(const string& ruta, ConfigBarrido& cfg) {
+    ifstream file(ruta);
+    if (!file) {
+        cerr << "Error: No se pudo abrir la configuración de barrido: " << ruta << endl;
+        return false;
+    }
+
+    string linea;
+    int num_linea = 0;
+    while (getline(file, linea)) {
+        num_linea++;
+        size_t comentario = linea.find('#');
+        if (comentario != string::npos) linea.erase(comentario);
+
+        istringstream campos(linea);
+        string clave;
+        if (!(campos >> clave)) continue;
+
+        bool ok = true;
+        if (clave == "INSTANCIAS") {
+            string valor;
+            while (campos >> valor) cfg.instancias.push_back(valor);
+        } else if (clave == "DRONES" || clave == "TICKS") {
+            vector<int>& lista = (clave == "DRONES") ? cfg.drones : cfg.ticks;
+            int valor;
+            while (campos >> valor) lista.push_back(valor);
+            ok = campos.eof();
+        } else if (clave == "ITERACIONES") {
+            ok = static_cast<bool>(campos >> cfg.iteraciones);
+        } else if (clave == "TIEMPO_MAX") {
+            ok = static_cast<bool>(campos >> cfg.criterio.tiempo_max_s);
+        } else if (clave == "MAX_EVALUACIONES") {
+            ok = static_cast<bool>(campos >> cfg.criterio.max_evaluaciones);
+        } else if (clave == "ESTANCAMIENTO") {
+            ok = static_cast<bool>(campos >> cfg.criterio.estancamiento);
+            if (ok && !(campos >> cfg.criterio.epsilon)) {
+                ok = campos.eof();
+                cfg.criterio.epsilon = 0.0;
+            }
+        } else if (clave == "MEMETICO") {
+            ok = static_cast<bool>(campos >> cfg.intervalo_memetico >> cfg.top_memetico >> cfg.pasos_memetico);
+        } else if (clave == "CACHE") {
+            ok = static_cast<bool>(campos >> cfg.entradas_cache);
+        } else if (clave == "REPETICIONES") {
+            ok = static_cast<bool>(campos >> cfg.repeticiones);
+        } else if (clave == "ELITE") {
+            ok = static_cast<bool>(campos >> cfg.elite);
+        } else if (clave == "SEMILLA") {
+            ok = static_cast<bool>(campos >> cfg.semilla);
+        } else if (clave == "RNG") {
+            string nombre;
+            campos >> nombre;
+            if (nombre == "mt19937") {
+                cfg.tipo_rng = RNG_MT19937;
+            } else if (nombre == "xoshiro") {
+                cfg.tipo_rng = RNG_XOSHIRO;
+            } else {
+                ok = false;
+            }
+        } else if (clave == "CONFIG") {
+            ConfigAE c;
+            ok = static_cast<bool>(campos >> c.nombre >> c.poblacion >> c.mutacion >> c.torneo);
+            if (ok) cfg.configuraciones.push_back(c);
+        } else {
+            cerr << "Error: " << ruta << ":" << num_linea << ": clave desconocida " << clave << endl;
+            return false;
+        }
+        if (!ok) {
+            cerr << "Error: " << ruta << ":" << num_linea << ": valores inválidos para " << clave << endl;
+            return false;
+        }
+    }
+
+    if (cfg.configuraciones.empty()) {
+        cfg.configuraciones.push_back({"defecto", 150, 0.05, 5});
+    }
+    if (cfg.instancias.empty() || cfg.drones.empty() || cfg.ticks.empty()) {
+        cerr << "Error: " << ruta << ": faltan INSTANCIAS, DRONES o TICKS" << endl;
+        return false;
+    }
+    if (cfg.repeticiones < 1) {
+        cerr << "Error: " << ruta << ": REPETICIONES debe ser al menos 1" << endl;
+        return false;
+    }
+    for (int k : cfg.drones) {
+        for (int T : cfg.ticks) {
+            for (const ConfigAE& c : cfg.configuraciones) {
+                ParametrosEjecucion p = {k, T, cfg.iteraciones, c.poblacion, c.mutacion, c.torneo,
+                                         cfg.elite, cfg.criterio, cfg.intervalo_memetico,
+                                         cfg.top_memetico, cfg.pasos_memetico, cfg.entradas_cache};
+                string origen = ruta + ": CONFIG " + c.nombre + " (k=" + to_string(k) + ", T=" +
+                                to_string(T) + "): ";
+                if (!parametrosValidos(p, origen)) return false;
+            }
+        }
+    }
+    return true;
+}
+
+/*
+ * ejecutarBarrido
+ * - Recibe: configuración del barrido, hilos, ruta del CSV consolidado
+ * Carga cada instancia una sola vez y reparte las ejecuciones independientes
+ * entre los hilos: cada trabajador toma la siguiente ejecución pendiente y la
+ * corre con un AE de un hilo. La semilla de cada ejecución se deriva de la
+ * semilla del barrido y del índice de la ejecución, así que el resultado no
+ * depende del número de hilos ni del orden en que terminan. Todas las filas
+ * se escriben al final, en orden, en un único CSV.
+ * - Retorna: void
+ */
+void ejecutarBarrido(const ConfigBarrido& cfg, int num_hilos, const string& salida) {
+    tipo_rng_defecto = cfg.tipo_rng;
+
+    vector<unique_ptr<Instancia>> instancias;
+    vector<string> nombres;
+    for (const string& ruta : cfg.instancias) {
+        instancias.emplace_back(new Instancia(ruta));
+        nombres.push_back(extraerNombreInstancia(ruta));
+    }
+
+    vector<EjecucionBarrido> ejecuciones;
+    GeneradorRng semillas(cfg.semilla);
+    for (size_t i = 0; i < instancias.size(); ++i) {
+        for (int k : cfg.drones) {
+            for (int T : cfg.ticks) {
+                for (size_t c = 0; c < cfg.configuraciones.size(); ++c) {
+                    for (int r = 0; r < cfg.repeticiones; ++r) {
+                        EjecucionBarrido e{};
+                        e.instancia = i;
+                        e.k = k;
+                        e.T = T;
+                        e.config = c;
+                        e.repeticion = r;
+                        e.semilla = static_cast<uint32_t>(semillas());
+                        ejecuciones.push_back(e);
+                    }
+                }
+            }
+        }
+    }
+
+    cout << "--- Barrido de experimentos (PSP-UAV) ---" << endl;
+    cout << "Ejecuciones: " << ejecuciones.size() << endl;
+    cout << "Hilos: " << num_hilos << endl;
+    cout << "Semilla: " << cfg.semilla << " (" << nombreRng(cfg.tipo_rng) << ")" << endl;
+    cout << "------------------------------------------------" << endl;
+
+    atomic<size_t> siguiente(0);
+    atomic<size_t> terminadas(0);
+    mutex mtx_salida;
+    function<void(int)> trabajador = [&](int) {
+        size_t idx;
+        while ((idx = siguiente++) < ejecuciones.size()) {
+            EjecucionBarrido& e = ejecuciones[idx];
+            const ConfigAE& c = cfg.configuraciones[e.config];
+            auto t_inicio = chrono::high_resolution_clock::now();
+
+            AlgoritmoEvolutivo ae(c.poblacion, c.mutacion, e.k, e.T, *instancias[e.instancia],
+                                  e.semilla, 1, 0, cfg.elite);
+            ae.tam_torneo = c.torneo;
+            if (cfg.intervalo_memetico > 0) {
+                ae.activarBusquedaLocal(cfg.intervalo_memetico, cfg.top_memetico, cfg.pasos_memetico);
+            }
+            ae.activarCache(cfg.entradas_cache);
+            CriterioParada criterio = cfg.criterio;
+            criterio.max_generaciones = cfg.iteraciones;
+            ControlParada parada(criterio);
+            ae.inicializarPoblacion();
+            long evaluaciones_previas = 0;
+            while (parada.continuar(ae.getMejorIndividuo().fitness,
+                                    ae.evaluacionesTotales() - evaluaciones_previas)) {
+                evaluaciones_previas = ae.evaluacionesTotales();
+                ae.ejecutarGeneracion();
+            }
+            e.generaciones = parada.generaciones();
+            e.motivo = parada.motivo();
+
+            const Individuo& mejor = ae.getMejorIndividuo();
+            e.fitness = mejor.fitness;
+            e.valido = mejor.es_valido;
+            e.evaluaciones = ae.evaluacionesTotales();
+            e.tasa_cache = ae.cache ? ae.tasaAciertosCache() : -1.0;
+            e.tiempo_s = chrono::duration<double>(chrono::high_resolution_clock::now() - t_inicio).count();
+
+            lock_guard<mutex> lock(mtx_salida);
+            cout << "[" << ++terminadas << "/" << ejecuciones.size() << "] "
+                 << nombres[e.instancia] << " k=" << e.k << " T=" << e.T
+                 << " " << c.nombre << " rep=" << e.repeticion
+                 << " fitness=" << fixed << setprecision(1) << e.fitness
+                 << (e.valido ? "" : " (inválida)") << endl;
         }
-        
-        if (pos.col > 0) {
-            acciones_validas.push_back(7); // Izquierda
+    };
+
+    if (num_hilos > 1) {
+        PoolHilos pool(num_hilos);
+        pool.ejecutar(trabajador);
+    } else {
+        trabajador(0);
+    }
+
+    size_t barra = salida.find_last_of('/');
+    if (barra != string::npos) crearDirectorio(salida.substr(0, barra));
+    ofstream archivo = abrirCSVAcumulativo(salida,
+        "instancia,config,poblacion,mutacion,torneo,repeticion,num_drones,iteraciones,"
+        "ticks_operacion,urgencia_acumulada,solucion_valida,tiempo_s,semilla,rng,evaluaciones,"
+        "generaciones,motivo_parada,tasa_cache");
+    for (const EjecucionBarrido& e : ejecuciones) {
+        const ConfigAE& c = cfg.configuraciones[e.config];
+        archivo << nombres[e.instancia] << ","
+                << c.nombre << ","
+                << c.poblacion << ","
+                << defaultfloat << c.mutacion << ","
+                << c.torneo << ","
+                << e.repeticion << ","
+                << e.k << ","
+                << cfg.iteraciones << ","
+                << e.T << ","
+                << fixed << setprecision(2) << e.fitness << ","
+                << (e.valido ? "Si" : "No") << ","
+                << setprecision(3) << e.tiempo_s << ","
+                << e.semilla << ","
+                << nombreRng(cfg.tipo_rng) << ","
+                << e.evaluaciones << ","
+                << e.generaciones << ","
+                << NOMBRES_PARADA[e.motivo] << ",";
+        if (e.tasa_cache >= 0) archivo << setprecision(4) << e.tasa_cache;
+        archivo << "\n";
+    }
+    archivo.close();
+    cout << "\nResultados del barrido guardados en: " << salida << endl;
+}
+
+#ifdef MODO_BENCH
+/*
+ * TablaBench
+ * Resultados de un benchmark en forma tabular para exportarlos como CSV o JSON.
+ */
+struct TablaBench {
+    string nombre;
+    vector<string> columnas;
+    vector<vector<string>> filas;
+};
+
+/*
+ * formatearNumero
+ * - Recibe: valor, cantidad de decimales
+ * - Retorna: texto con el valor en notación fija
+ */
+string formatearNumero(double valor, int decimales) {
+    stringstream ss;
+    ss << fixed << setprecision(decimales) << valor;
+    return ss.str();
+}
+
+/*
+ * ejecutarEnProcesoHijo
+ * - Recibe: carga que produce una fila de resultados
+ * Ejecuta la carga en un proceso hijo (fork) y recibe la fila por un pipe.
+ * Así el pico de memoria residente que informa wait4 es el de esa carga más
+ * la memoria heredada del padre al hacer fork; el ru_maxrss del propio
+ * proceso solo crece y repetiría el de la carga más grande ya ejecutada.
+ * - Retorna: la fila con el pico de RSS del hijo (KB) agregado al final
+ */
+vector<string> ejecutarEnProcesoHijo(const function<vector<string>()>& carga) {
+    int tubo[2];
+    if (pipe(tubo) != 0) throw runtime_error("no se pudo crear el pipe del benchmark");
+    cout.flush();
+    pid_t hijo = fork();
+    if (hijo < 0) throw runtime_error("no se pudo crear el proceso del benchmark");
+    if (hijo == 0) {
+        close(tubo[0]);
+        int codigo = 0;
+        try {
+            string texto;
+            for (const string& valor : carga()) texto += valor + "\n";
+            for (size_t escrito = 0; escrito < texto.size();) {
+                ssize_t n = write(tubo[1], texto.data() + escrito, texto.size() - escrito);
+                if (n <= 0) { codigo = 1; break; }
+                escrito += n;
+            }
+        } catch (const exception& e) {
+            cerr << "Error: " << e.what() << endl;
+            codigo = 1;
         }
-        
-        // Retornar acción válida aleatoria
-        uniform_int_distribution<int> dist(0, acciones_validas.size() - 1);
-        return acciones_validas[dist(rng)];
+        close(tubo[1]);
+        _exit(codigo);
     }
+    close(tubo[1]);
+    string texto;
+    char bloque[4096];
+    ssize_t n;
+    while ((n = read(tubo[0], bloque, sizeof(bloque))) > 0) texto.append(bloque, n);
+    close(tubo[0]);
 
-    /*
-     * mutar
-     * - Recibe: individuo a mutar
-     * Cambia aleatoriamente algunas acciones según la tasa de mutación.
-     * MEJORADO: Ahora solo genera acciones que mantienen al dron dentro de la grilla.
-     * - Retorna: void (modifica el individuo recibido)
-     */
-    void mutar(Individuo& ind) {
-        uniform_real_distribution<double> dist_muta(0.0, 1.0);
-        
-        for (int d = 0; d < k_drones; ++d) {
-            // Simular trayectoria para conocer posición en cada tick
-            Coordenada pos_actual = inst.bases[ind.base_ids[d]];
-            
-            for (int t = 0; t < T_ticks; ++t) {
-                if (dist_muta(rng) < tasa_mutacion) {
-                    // Generar acción VÁLIDA (que no saque de la grilla)
-                    ind.acciones[d][t] = generarAccionValida(pos_actual);
-                }
-                
-                // Actualizar posición para siguiente tick
-                pos_actual = aplicarAccion(pos_actual, ind.acciones[d][t]);
+    int estado = 0;
+    struct rusage uso;
+    if (wait4(hijo, &estado, 0, &uso) != hijo || !WIFEXITED(estado) || WEXITSTATUS(estado) != 0) {
+        throw runtime_error("falló el proceso hijo del benchmark");
+    }
+    vector<string> fila;
+    stringstream ss(texto);
+    for (string valor; getline(ss, valor);) fila.push_back(valor);
+    fila.push_back(to_string(uso.ru_maxrss));
+    return fila;
+}
+
+/*
+ * escribirTablasCSV
+ * - Recibe: flujo de salida, tablas
+ * Escribe cada tabla como un bloque CSV precedido por "# nombre".
+ * - Retorna: void
+ */
+void escribirTablasCSV(ostream& out, const vector<TablaBench>& tablas) {
+    for (size_t i = 0; i < tablas.size(); ++i) {
+        const TablaBench& tabla = tablas[i];
+        if (i > 0) out << "\n";
+        out << "# " << tabla.nombre << "\n";
+        for (size_t c = 0; c < tabla.columnas.size(); ++c) {
+            out << (c ? "," : "") << tabla.columnas[c];
+        }
+        out << "\n";
+        for (const auto& fila : tabla.filas) {
+            for (size_t c = 0; c < fila.size(); ++c) {
+                out << (c ? "," : "") << fila[c];
             }
+            out << "\n";
         }
     }
+}
 
-    /*
-     * repararIndividuo
-     * - Recibe: individuo a reparar
-     * Corrige acciones que sacarían al dron fuera de la grilla (forzando "permanecer").
-     * - Retorna: void (modifica el individuo recibido)
-     */
-    void repararIndividuo(Individuo& ind) {
-        for (int d = 0; d < k_drones; ++d) {
-            Coordenada pos = inst.bases[ind.base_ids[d]];
-            
-            for (int t = 0; t < T_ticks; ++t) {
-                int accion = ind.acciones[d][t];
-                Coordenada nueva_pos = aplicarAccion(pos, accion);
-                
-                // Si la acción saca de la grilla, forzar "permanecer"
-                if (nueva_pos.fila < 0 || nueva_pos.fila >= inst.filas ||
-                    nueva_pos.col < 0 || nueva_pos.col >= inst.columnas) {
-                    ind.acciones[d][t] = 0; // Permanecer
-                } else {
-                    pos = nueva_pos; // Actualizar posición
-                }
+/*
+ * escribirTablasJSON
+ * - Recibe: flujo de salida, tablas
+ * Escribe un objeto JSON con un arreglo de filas por tabla. Los valores
+ * numéricos se emiten como números y el resto como texto.
+ * - Retorna: void
+ */
+void escribirTablasJSON(ostream& out, const vector<TablaBench>& tablas) {
+    auto valor = [](const string& v) {
+        char* fin = nullptr;
+        strtod(v.c_str(), &fin);
+        bool numerico = !v.empty() && fin && *fin == '\0';
+        return numerico ? v : "\"" + v + "\"";
+    };
+    out << "{\n";
+    for (size_t i = 0; i < tablas.size(); ++i) {
+        const TablaBench& tabla = tablas[i];
+        out << "  \"" << tabla.nombre << "\": [";
+        for (size_t f = 0; f < tabla.filas.size(); ++f) {
+            out << (f ? ",\n    {" : "\n    {");
+            for (size_t c = 0; c < tabla.columnas.size(); ++c) {
+                out << (c ? ", " : "") << "\"" << tabla.columnas[c] << "\": " << valor(tabla.filas[f][c]);
             }
+            out << "}";
         }
+        out << "\n  ]" << (i + 1 < tablas.size() ? "," : "") << "\n";
     }
+    out << "}\n";
+}
 
-    /*
-     * ejecutarGeneracion
-     * - Recibe: nada (usa la población actual)
-     * Aplica elitismo, selección, cruce y mutación para crear nueva generación.
-     * - Retorna: void (reemplaza la población actual)
-     */
-    void ejecutarGeneracion() {
-        vector<Individuo> nueva_poblacion;
+/*
+ * benchFases
+ * - Recibe: ruta de instancia, k, T, generaciones, tabla de resultados
+ * Ejecuta el AE con semilla fija en un hilo midiendo por separado cada fase
+ * (inicialización, selección, cruce, mutación, reparación, evaluación), más
+ * evaluaciones por segundo de evaluación, ns por tick simulado y pico de RSS.
+ * Corre en un proceso hijo para que el pico de RSS sea el de esta carga.
+ * - Retorna: void (agrega una fila a la tabla)
+ */
+void benchFases(const string& ruta, int k, int T, int generaciones, TablaBench& tabla) {
+    tabla.filas.push_back(ejecutarEnProcesoHijo([&]() {
+        Instancia inst(ruta);
+        AlgoritmoEvolutivo ae(150, 0.05, k, T, inst, 12345, 1);
+        ae.medir_tiempos = true;
 
-        // Elitismo: preservar el mejor
-        sort(poblacion.begin(), poblacion.end(), 
-            [](const Individuo& a, const Individuo& b) {
-                return a.fitness < b.fitness;
-            });
-        
-        nueva_poblacion.push_back(poblacion[0]);
+        auto t0 = chrono::steady_clock::now();
+        ae.inicializarPoblacion();
+        for (int g = 0; g < generaciones; ++g) {
+            ae.ejecutarGeneracion();
+        }
+        double total_s = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+        double evaluacion_s = ae.tiempoFase(FASE_EVALUACION);
+        long evaluaciones = ae.evaluacionesTotales();
+        long ticks = ae.ticksTotales();
 
-        // Crear nuevos individuos
-        while (nueva_poblacion.size() < static_cast<size_t>(tam_poblacion)) {
-            const Individuo& p1 = seleccionarPorTorneo(5);
-            const Individuo& p2 = seleccionarPorTorneo(5);
-
-            Individuo hijo = cruzarUnPunto(p1, p2);
-            mutar(hijo);
-            repararIndividuo(hijo); // Garantizar que el hijo sea válido espacialmente
-            calcularFitness(hijo, inst, T_ticks);
-            
-            nueva_poblacion.push_back(hijo);
+        vector<string> fila = {extraerNombreInstancia(ruta), to_string(k), to_string(T),
+                               to_string(generaciones), formatearNumero(total_s * 1e3, 3)};
+        for (int f = 0; f < NUM_FASES; ++f) {
+            fila.push_back(formatearNumero(ae.tiempoFase(f) * 1e3, 3));
         }
+        fila.push_back(to_string(evaluaciones));
+        fila.push_back(formatearNumero(evaluaciones / evaluacion_s, 0));
+        fila.push_back(formatearNumero(ticks > 0 ? evaluacion_s * 1e9 / ticks : 0.0, 2));
+        fila.push_back(formatearNumero(ae.getMejorIndividuo().fitness, 1));
+        return fila;
+    }));
+}
+
+/*
+ * benchSobrecargaGeneracion
+ * - Recibe: ruta de instancia, k, T, generaciones, tamaño de población, elitistas, tabla
+ * Micro-benchmark del costo por generación SIN contar la evaluación de fitness
+ * (selección, élite, cruce, mutación, reparación e intercambio de buffers).
+ * Compara además la selección de élite sobre índices con ordenar la población
+ * completa de Individuo como se hacía antes.
+ * - Retorna: void (agrega una fila a la tabla)
+ */
+void benchSobrecargaGeneracion(const string& ruta, int k, int T, int generaciones,
+                               int pop_size, int elite, TablaBench& tabla) {
+    Instancia inst(ruta);
+    AlgoritmoEvolutivo ae(pop_size, 0.05, k, T, inst, 12345, 1, 0, elite);
+    ae.medir_tiempos = true;
+    ae.inicializarPoblacion();
 
-        poblacion = nueva_poblacion;
+    auto t0 = chrono::steady_clock::now();
+    for (int g = 0; g < generaciones; ++g) {
+        ae.ejecutarGeneracion();
     }
+    double total_s = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    double sobrecarga_us = (total_s - ae.tiempoFase(FASE_EVALUACION)) / generaciones * 1e6;
 
-    /*
-     * getMejorIndividuo
-     * - Recibe: nada
-     * Encuentra el individuo con menor fitness (mejor solución).
-     * - Retorna: copia del mejor individuo
-     */
-    Individuo getMejorIndividuo() {
-        sort(poblacion.begin(), poblacion.end(), 
-            [](const Individuo& a, const Individuo& b) {
-                return a.fitness < b.fitness;
-            });
-        return poblacion[0];
+    // Selección de élite sobre índices vs sort de la población completa
+    const int repeticiones = 200;
+    double indices_s = 0.0;
+    double sort_s = 0.0;
+    mt19937 mezcla(7);
+    for (int r = 0; r < repeticiones; ++r) {
+        auto t_ini = chrono::steady_clock::now();
+        ae.seleccionarElite();
+        indices_s += chrono::duration<double>(chrono::steady_clock::now() - t_ini).count();
+
+        vector<Individuo> copia = ae.poblacion;
+        shuffle(copia.begin(), copia.end(), mezcla);
+        t_ini = chrono::steady_clock::now();
+        sort(copia.begin(), copia.end(), [](const Individuo& a, const Individuo& b) {
+            return a.fitness < b.fitness;
+        });
+        sort_s += chrono::duration<double>(chrono::steady_clock::now() - t_ini).count();
     }
-};
+
+    tabla.filas.push_back({extraerNombreInstancia(ruta), to_string(k), to_string(T),
+                           to_string(pop_size), to_string(elite), to_string(generaciones),
+                           formatearNumero(sobrecarga_us, 3),
+                           formatearNumero(indices_s / repeticiones * 1e6, 3),
+                           formatearNumero(sort_s / repeticiones * 1e6, 3)});
+}
 
 /*
- * guardarResultadosCSV
- * - Recibe: nombre instancia, parámetros, mejor individuo, tiempo ejecución
- * Guarda estadísticas de ejecución en archivo CSV.
- * - Retorna: void
+ * benchPipelineHijos
+ * - Recibe: ruta de instancia, k, T, generaciones, evaluador perezoso o no, tabla
+ * Compara (A/B, misma semilla) la producción de hijos clásica (cruce, mutación,
+ * reparación y evaluación en lote, cada una recorriendo el plan) con la
+ * pasada única de producirHijoFusionado. Mide solo las generaciones, sin la
+ * población inicial; alterna los dos caminos en tres rondas y toma el mejor
+ * tiempo de cada uno.
+ * - Retorna: void (agrega una fila a la tabla)
  */
-void guardarResultadosCSV(const string& nombre_instancia, int num_drones, int K_iter, 
-                          int T_ticks, const Individuo& mejor_ind, double tiempo_s) {
-    crearDirectorio("resultados");
-    
-    stringstream ss;
-    ss << "resultados/" << nombre_instancia << "_estadisticas.csv";
-    
-    // Verificar si el archivo ya existe para saber si escribir encabezado
-    bool existe = ifstream(ss.str()).good();
-    
-    ofstream archivo(ss.str(), ios::app);  // Modo append
-    
-    // Escribir encabezado solo si es archivo nuevo
-    if (!existe) {
-        archivo << "num_drones,iteraciones,ticks_operacion,urgencia_acumulada,solucion_valida,tiempo_s\n";
+void benchPipelineHijos(const string& ruta, int k, int T, int generaciones, bool perezoso,
+                        TablaBench& tabla) {
+    Instancia inst(ruta);
+    bool perezoso_previo = evaluacion_perezosa_defecto;
+    evaluacion_perezosa_defecto = perezoso;
+    double tiempo_ms[2] = {numeric_limits<double>::infinity(), numeric_limits<double>::infinity()};
+    double mejor[2];
+    for (int ronda = 0; ronda < 3; ++ronda) {
+        for (int fusionado = 0; fusionado < 2; ++fusionado) {
+            AlgoritmoEvolutivo ae(150, 0.05, k, T, inst, 12345, 1);
+            ae.fusionado = fusionado;
+            ae.inicializarPoblacion();
+            auto t0 = chrono::steady_clock::now();
+            for (int g = 0; g < generaciones; ++g) {
+                ae.ejecutarGeneracion();
+            }
+            double ms = chrono::duration<double>(chrono::steady_clock::now() - t0).count() * 1e3;
+            tiempo_ms[fusionado] = min(tiempo_ms[fusionado], ms);
+            mejor[fusionado] = ae.getMejorIndividuo().fitness;
+        }
     }
-    
-    // Agregar fila de datos
-    archivo << num_drones << ","
-            << K_iter << ","
-            << T_ticks << ","
-            << fixed << setprecision(2) << mejor_ind.fitness << ","
-            << (mejor_ind.es_valido ? "Si" : "No") << ","
-            << setprecision(3) << tiempo_s << "\n";
-    
-    archivo.close();
-    cout << "\nEstadísticas guardadas en: " << ss.str() << endl;
+    evaluacion_perezosa_defecto = perezoso_previo;
+    tabla.filas.push_back({extraerNombreInstancia(ruta), to_string(k), to_string(T),
+                           perezoso ? "perezoso" : "completo", to_string(generaciones),
+                           formatearNumero(tiempo_ms[0], 3), formatearNumero(tiempo_ms[1], 3),
+                           formatearNumero(tiempo_ms[0] / tiempo_ms[1], 2),
+                           formatearNumero(mejor[0], 1), formatearNumero(mejor[1], 1)});
 }
 
 /*
- * guardarRutasCSV
- * - Recibe: nombre instancia, parámetros, mejor individuo, instancia problema, horizonte T
- * Guarda las rutas de cada dron en formato CSV para visualización.
- * - Retorna: void
+ * benchMultiobjetivo
+ * - Recibe: ruta de instancia, máximo de drones, T, tamaño de población, generaciones, tabla
+ * Mide el tiempo total de las generaciones NSGA-II y la parte dedicada al
+ * ordenamiento por frentes y al hacinamiento (2N soluciones por generación).
+ * - Retorna: void (agrega una fila a la tabla)
  */
-void guardarRutasCSV(const string& nombre_instancia, int num_drones, int K_iter,
-                     int T_ticks, const Individuo& mejor_ind, 
-                     const Instancia& inst, int T) {
-    crearDirectorio("resultados");
-    
-    stringstream ss;
-    ss << "resultados/" << nombre_instancia << "_rutas.csv";
-    
-    // Verificar si el archivo ya existe para saber si escribir encabezado
-    bool existe = ifstream(ss.str()).good();
-    
-    ofstream archivo(ss.str(), ios::app);  // Modo append
-    
-    // Escribir encabezado solo si es archivo nuevo
-    if (!existe) {
-        archivo << "num_drones,dron,tick,fila,columna,accion,base_origen\n";
+void benchMultiobjetivo(const string& ruta, int k_max, int T, int pop_size, int generaciones,
+                        TablaBench& tabla) {
+    Instancia inst(ruta);
+    AlgoritmoMultiobjetivo mo(pop_size, 0.05, k_max, T, inst, 12345, 1);
+    mo.inicializarPoblacion();
+    mo.tiempo_ordenamiento_s = 0.0;
+    auto t0 = chrono::steady_clock::now();
+    for (int g = 0; g < generaciones; ++g) {
+        mo.ejecutarGeneracion();
     }
-    
-    int k = mejor_ind.base_ids.size();
-    vector<Coordenada> pos_actuales(k);
-    
-    // Posiciones iniciales
-    for (int d = 0; d < k; ++d) {
-        int id_base = mejor_ind.base_ids[d];
-        Coordenada pos_base = inst.bases[id_base];
-        pos_actuales[d] = pos_base;
-        
-        // Tick 0 (posición inicial)
-        archivo << num_drones << "," << d << ",0," << pos_base.fila << "," << pos_base.col 
-                << ",0," << id_base << "\n";
+    double total_ms = chrono::duration<double>(chrono::steady_clock::now() - t0).count() * 1e3;
+    tabla.filas.push_back({extraerNombreInstancia(ruta), to_string(k_max), to_string(T), to_string(pop_size),
+                           to_string(generaciones), formatearNumero(total_ms, 3),
+                           formatearNumero(mo.tiempo_ordenamiento_s * 1e3, 3),
+                           to_string(mo.frentePareto().size())});
+}
+
+/*
+ * benchEvaluacionLote
+ * - Recibe: ruta de instancia, k, T, número de planes, tabla
+ * Mide el throughput (evaluaciones por segundo) de evaluar planes reparados
+ * uno por uno con evaluar, todos juntos con evaluarLote y en lote con el
+ * modo perezoso (mejor de tres rondas).
+ * - Retorna: void (agrega una fila a la tabla)
+ */
+void benchEvaluacionLote(const string& ruta, int k, int T, int num_planes, TablaBench& tabla) {
+    Instancia inst(ruta);
+    MotorEvaluacion motor(inst);
+    AlgoritmoEvolutivo ae(0, 0.0, k, T, inst);
+    GeneradorRng gen(12345);
+    vector<Individuo> planes(num_planes);
+    vector<TareaEvaluacion> tareas;
+    for (Individuo& ind : planes) {
+        ind.inicializarAleatorio(k, T, inst, gen);
+        ae.repararIndividuo(ind);
+        tareas.push_back({&ind, nullptr, 0});
     }
-    
-    // Simular cada tick
-    for (int t = 0; t < T; ++t) {
-        for (int d = 0; d < k; ++d) {
-            int accion = mejor_ind.acciones[d][t];
-            Coordenada nueva_pos = aplicarAccion(pos_actuales[d], accion);
-            
-            archivo << num_drones << "," << d << "," << (t + 1) << "," 
-                    << nueva_pos.fila << "," << nueva_pos.col << "," 
-                    << accion << "," << mejor_ind.base_ids[d] << "\n";
-            
-            pos_actuales[d] = nueva_pos;
+
+    // Mejor de tres rondas, alternando los modos para no favorecer al primero
+    double individual_s = numeric_limits<double>::infinity();
+    double lote_s = individual_s;
+    double perezoso_s = individual_s;
+    auto medir = [](double& mejor_s, const function<void()>& evaluar) {
+        auto t0 = chrono::steady_clock::now();
+        evaluar();
+        mejor_s = min(mejor_s, chrono::duration<double>(chrono::steady_clock::now() - t0).count());
+    };
+    for (int ronda = 0; ronda < 3; ++ronda) {
+        motor.usarEvaluacionPerezosa(false);
+        medir(individual_s, [&]() { for (Individuo& ind : planes) motor.evaluar(ind, T); });
+        medir(lote_s, [&]() { motor.evaluarLote(tareas.data(), tareas.size(), T); });
+        motor.usarEvaluacionPerezosa(true);
+        medir(perezoso_s, [&]() { motor.evaluarLote(tareas.data(), tareas.size(), T); });
+    }
+
+    tabla.filas.push_back({extraerNombreInstancia(ruta), to_string(k), to_string(T),
+                           to_string(num_planes), formatearNumero(num_planes / individual_s, 0),
+                           formatearNumero(num_planes / lote_s, 0),
+                           formatearNumero(num_planes / perezoso_s, 0)});
+}
+
+/*
+ * benchCargaInstancia
+ * - Recibe: dimensiones de una grilla sintética, número de urgencias, repeticiones, tabla
+ * Genera con semilla fija una instancia de texto (5 % de obstáculos, 4 bases),
+ * la convierte a binario y mide el tiempo de arranque (construir Instancia,
+ * incluidas las tablas precalculadas) con cada formato.
+ * - Retorna: void (agrega una fila a la tabla; borra los archivos temporales)
+ */
+void benchCargaInstancia(int filas, int columnas, int num_urgencias, int repeticiones, TablaBench& tabla) {
+    string base = "bench_instancia_" + to_string(filas) + "x" + to_string(columnas);
+    string ruta_texto = base + ".txt";
+    string ruta_binaria = base + ".bin";
+    {
+        mt19937 gen(99);
+        uniform_int_distribution<int> dist_fila(0, filas - 1);
+        uniform_int_distribution<int> dist_col(0, columnas - 1);
+        set<Coordenada> obstaculos;
+        while (obstaculos.size() < static_cast<size_t>(filas) * columnas / 20) {
+            obstaculos.insert({dist_fila(gen), dist_col(gen)});
+        }
+        vector<Coordenada> bases;
+        while (bases.size() < 4) {
+            Coordenada c = {dist_fila(gen), dist_col(gen)};
+            if (!obstaculos.count(c)) bases.push_back(c);
+        }
+        ofstream archivo(ruta_texto);
+        archivo << "GRID_ROWS " << filas << "\nGRID_COLS " << columnas << "\n\n";
+        archivo << "N_OBSTACLES " << obstaculos.size() << "\n";
+        for (const Coordenada& c : obstaculos) archivo << c.fila << " " << c.col << "\n";
+        archivo << "\nN_URGENCIES " << num_urgencias << "\n";
+        for (int i = 0; i < num_urgencias; ++i) {
+            archivo << dist_fila(gen) << " " << dist_col(gen) << " " << 1 + static_cast<int>(gen() % 10) << "\n";
+        }
+        archivo << "\nN_BASES " << bases.size() << "\n";
+        for (size_t i = 0; i < bases.size(); ++i) {
+            archivo << i << " " << bases[i].fila << " " << bases[i].col << "\n";
         }
     }
-    
-    archivo.close();
-    cout << "Rutas guardadas en: " << ss.str() << endl;
+    Instancia(ruta_texto).guardarBinario(ruta_binaria);
+
+    auto medir = [&](const string& ruta) {
+        double mejor_ms = numeric_limits<double>::infinity();
+        for (int r = 0; r < repeticiones; ++r) {
+            auto t0 = chrono::steady_clock::now();
+            Instancia inst(ruta);
+            double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+            mejor_ms = min(mejor_ms, ms);
+        }
+        return mejor_ms;
+    };
+    auto bytes = [](const string& ruta) {
+        struct stat info;
+        return stat(ruta.c_str(), &info) == 0 ? static_cast<long>(info.st_size) : 0L;
+    };
+
+    double texto_ms = medir(ruta_texto);
+    double binario_ms = medir(ruta_binaria);
+    tabla.filas.push_back({to_string(filas), to_string(columnas), to_string(num_urgencias),
+                           to_string(bytes(ruta_texto)), to_string(bytes(ruta_binaria)),
+                           formatearNumero(texto_ms, 3), formatearNumero(binario_ms, 3)});
+    remove(ruta_texto.c_str());
+    remove(ruta_binaria.c_str());
 }
 
 /*
- * imprimirMejorRuta
- * - Recibe: mejor individuo, instancia del problema, horizonte temporal T
- * Re-simula el plan de vuelo y muestra las rutas de cada dron.
- * - Retorna: void (imprime en consola)
+ * main (benchmark)
+ * Binario PSP-UAV-bench: suite de benchmarks con semilla fija sobre todas las
+ * instancias y una grilla de k y T. Escribe CSV por salida estándar y,
+ * opcionalmente, JSON en un archivo.
+ * Uso: ./PSP-UAV-bench [--generaciones <n>] [--json <archivo>] [ruta_instancia...]
  */
-void imprimirMejorRuta(const Individuo& mejor_ind, const Instancia& inst, int T) {
-    int k = mejor_ind.base_ids.size();
-    
-    vector<vector<Coordenada>> historial_rutas(k);
-    vector<Coordenada> pos_actuales(k);
+int main(int argc, char* argv[]) {
+    vector<string> rutas;
+    int generaciones = 100;
+    string ruta_json;
+    for (int i = 1; i < argc; ++i) {
+        string opcion = argv[i];
+        if (opcion == "--generaciones" && i + 1 < argc) {
+            generaciones = stoi(argv[++i]);
+            if (generaciones < 1) {
+                cerr << "Error: --generaciones debe ser al menos 1" << endl;
+                return 1;
+            }
+        } else if (opcion == "--json" && i + 1 < argc) {
+            ruta_json = argv[++i];
+        } else {
+            rutas.push_back(opcion);
+        }
+    }
+    if (rutas.empty()) {
+        for (const char* id : {"01_a", "01_b", "02_a", "02_b", "03_a", "03_b"}) {
+            rutas.push_back(string("instancias/PSP-UAV_") + id + ".txt");
+        }
+    }
 
-    // Posiciones iniciales en bases
-    for (int d = 0; d < k; ++d) {
-        int id_base = mejor_ind.base_ids[d];
-        Coordenada pos_base = inst.bases[id_base];
-        historial_rutas[d].push_back(pos_base);
-        pos_actuales[d] = pos_base;
+    TablaBench fases{"fases", {"instancia", "k", "T", "generaciones", "total_ms"}, {}};
+    for (int f = 0; f < NUM_FASES; ++f) {
+        fases.columnas.push_back(string(NOMBRES_FASES[f]) + "_ms");
+    }
+    for (const char* columna : {"evaluaciones", "eval_s", "ns_tick", "mejor_fitness", "pico_rss_kb"}) {
+        fases.columnas.push_back(columna);
     }
+    TablaBench sobrecarga{"sobrecarga_generacion",
+                          {"instancia", "k", "T", "poblacion", "elite", "generaciones",
+                           "sobrecarga_generacion_us", "elite_indices_us", "sort_poblacion_us"}, {}};
+    TablaBench lote{"evaluacion_lote",
+                    {"instancia", "k", "T", "planes", "eval_s_individual", "eval_s_lote",
+                     "eval_s_perezoso"}, {}};
+    TablaBench pipeline{"pipeline_hijos",
+                        {"instancia", "k", "T", "evaluador", "generaciones", "clasico_ms", "fusionado_ms",
+                         "aceleracion", "mejor_clasico", "mejor_fusionado"}, {}};
+    TablaBench multiobjetivo{"multiobjetivo",
+                             {"instancia", "k_max", "T", "poblacion", "generaciones", "total_ms",
+                              "ordenamiento_ms", "tam_frente"}, {}};
+    TablaBench carga{"carga_instancia",
+                     {"filas", "columnas", "urgencias", "bytes_texto", "bytes_binario",
+                      "texto_ms", "binario_ms"}, {}};
 
-    // Re-simular cada tick
-    for (int t = 0; t < T; ++t) {
-        for (int d = 0; d < k; ++d) {
-            int accion = mejor_ind.acciones[d][t];
-            Coordenada nueva_pos = aplicarAccion(pos_actuales[d], accion);
-            historial_rutas[d].push_back(nueva_pos);
-            pos_actuales[d] = nueva_pos;
+    // Las filas de fases corren en procesos hijo que heredan la memoria
+    // residente del padre: van primero, antes de que las demás tablas la hagan crecer
+    for (const string& ruta : rutas) {
+        for (int k : {3, 5, 10}) {
+            for (int T : {50, 200}) {
+                benchFases(ruta, k, T, generaciones, fases);
+            }
         }
     }
-
-    // Imprimir formato: D1: B0 - (f,c) - ...
-    cout << "Rutas:" << endl;
-    for (int d = 0; d < k; ++d) {
-        cout << "D" << (d + 1) << ": B" << mejor_ind.base_ids[d];
-        for (size_t t = 1; t < historial_rutas[d].size(); ++t) {
-            const auto& pos = historial_rutas[d][t];
-            cout << " - (" << pos.fila << "," << pos.col << ")";
+    for (const string& ruta : rutas) {
+        for (int elite : {1, 5}) {
+            benchSobrecargaGeneracion(ruta, 5, 50, generaciones, 150, elite, sobrecarga);
         }
-        cout << endl;
+        for (int k : {3, 10}) {
+            benchEvaluacionLote(ruta, k, 200, 2000, lote);
+        }
+        for (int k : {5, 10}) {
+            for (int T : {50, 200}) {
+                for (bool perezoso : {false, true}) {
+                    benchPipelineHijos(ruta, k, T, generaciones, perezoso, pipeline);
+                }
+            }
+        }
+        for (int pop_size : {500, 4000}) {
+            benchMultiobjetivo(ruta, 10, 50, pop_size, max(1, generaciones / 10), multiobjetivo);
+        }
+    }
+
+    for (int lado : {10, 100, 300}) {
+        benchCargaInstancia(lado, lado, lado * lado / 10, 5, carga);
+    }
+
+    vector<TablaBench> tablas = {fases, sobrecarga, lote, pipeline, multiobjetivo, carga};
+    escribirTablasCSV(cout, tablas);
+    if (!ruta_json.empty()) {
+        ofstream archivo(ruta_json);
+        escribirTablasJSON(archivo, tablas);
+        cerr << "JSON guardado en: " << ruta_json << endl;
     }
+    return 0;
 }
+#else
+/*
+ * ejecutarPrograma
+ * - Recibe: argumentos de línea de comandos
+ * Cuerpo del programa principal (modos de ejecución, verificación, barrido y conversión).
+ * - Retorna: código de salida del proceso
+ */
+int ejecutarPrograma(int argc, char* argv[]) {
+    // Modo conversión: instancia de texto (o binaria) a formato binario
+    if (argc == 4 && string(argv[1]) == "--convertir") {
+        Instancia inst(argv[2]);
+        inst.guardarBinario(argv[3]);
+        cout << "Instancia " << argv[2] << " (" << inst.filas << "x" << inst.columnas << ", "
+             << inst.tasas_densas.size() << " urgencias) guardada en formato binario en "
+             << argv[3] << endl;
+        return 0;
+    }
+
+    // Modo verificación: comparar MotorEvaluacion contra el simulador de referencia
+    if (argc >= 3 && string(argv[1]) == "--verificar") {
+        return verificarMotor(vector<string>(argv + 2, argv + argc)) == 0 ? 0 : 1;
+    }
+
+    // Modo barrido: muchas ejecuciones independientes descritas en un archivo
+    if (argc >= 3 && string(argv[1]) == "--barrido") {
+        ConfigBarrido cfg;
+        if (!cargarConfiguracionBarrido(argv[2], cfg)) return 1;
+        int num_hilos = 1;
+        string salida = "resultados/barrido_estadisticas.csv";
+        for (int i = 3; i < argc; ++i) {
+            string opcion = argv[i];
+            if (opcion == "--hilos" && i + 1 < argc) {
+                num_hilos = stoi(argv[++i]);
+                if (num_hilos == 0) num_hilos = thread::hardware_concurrency();
+            } else if (opcion == "--salida" && i + 1 < argc) {
+                salida = argv[++i];
+            } else {
+                cerr << "Error: Opción desconocida o incompleta: " << opcion << endl;
+                return 1;
+            }
+        }
+        ejecutarBarrido(cfg, num_hilos, salida);
+        return 0;
+    }
 
-int main(int argc, char* argv[]) {
     // Validar argumentos
-    if (argc != 5) {
+    if (argc < 5) {
         cerr << "Error: Argumentos incorrectos." << endl;
-        cerr << "Uso: ./PSP-UAV <ruta_instancia> <num_drones> <K_iteraciones> <T_ticks>" << endl;
+        cerr << "Uso: ./PSP-UAV <ruta_instancia> <num_drones> <K_iteraciones> <T_ticks> [opciones]" << endl;
+        cerr << "Opciones:" << endl;
+        cerr << "  --hilos <n>      Evalúa la generación en n hilos (por defecto 1)" << endl;
+        cerr << "  --controles <n>  Puntos de control de simulación por individuo (por defecto 0)" << endl;
+        cerr << "  --elite <n>      Individuos preservados por elitismo (por defecto 1)" << endl;
+        cerr << "  --kernel <k>     Kernel de urgencias: auto, escalar, sse2, avx2 (por defecto auto)" << endl;
+        cerr << "  --evaluador <e>  Acumulación de urgencias: denso o perezoso (por defecto denso)" << endl;
+        cerr << "  --semilla <s>    Semilla maestra (por defecto aleatoria)" << endl;
+        cerr << "  --rng <tipo>     Generador: mt19937 o xoshiro (por defecto mt19937)" << endl;
+        cerr << "  --poblacion <n>  Tamaño de la población (por defecto 150)" << endl;
+        cerr << "  --mutacion <p>   Tasa de mutación por gen (por defecto 0.05)" << endl;
+        cerr << "  --torneo <n>     Tamaño del torneo de selección (por defecto 5)" << endl;
+        cerr << "  --operadores <op[:peso],...>  Operadores de mutación: puntual, intercambio, segmento, urgencia" << endl;
+        cerr << "  --fusionado      Cruza, muta, repara y evalúa cada hijo en una sola pasada" << endl;
+        cerr << "  --multiobjetivo  NSGA-II: frente de Pareto de urgencia vs. 1..num_drones drones activos" << endl;
+        cerr << "  --tiempo-max <s>          Detiene la evolución tras s segundos de reloj" << endl;
+        cerr << "  --max-evaluaciones <n>    Detiene la evolución tras n evaluaciones de fitness" << endl;
+        cerr << "  --estancamiento <n>       Detiene la evolución tras n generaciones sin mejora" << endl;
+        cerr << "  --epsilon <e>             Mejora relativa mínima para el estancamiento (por defecto 0)" << endl;
+        cerr << "  --memetico <g>            Refina a los mejores con búsqueda local cada g generaciones" << endl;
+        cerr << "  --memetico-top <m>        Individuos refinados por etapa (por defecto 2)" << endl;
+        cerr << "  --memetico-pasos <p>      Pasos de búsqueda local por individuo (por defecto 20)" << endl;
+        cerr << "  --sin-rutas               No imprime las rutas en consola" << endl;
+        cerr << "  --rutas <formato>         Archivo de rutas: csv, binario o ninguno (por defecto csv)" << endl;
+        cerr << "  --cache <n>               Caché de fitness de n entradas (por defecto 0 = desactivada)" << endl;
+        cerr << "  --traza <archivo>         Traza de convergencia por generación (.csv o .json)" << endl;
+        cerr << "  --traza-buffer <n>        Generaciones guardadas en memoria entre volcados (por defecto 1024)" << endl;
+        cerr << "  --checkpoint <archivo>    Guarda el estado del AE en segundo plano (binario)" << endl;
+        cerr << "  --checkpoint-cada <g>     Generaciones entre checkpoints (por defecto 100)" << endl;
+        cerr << "  --reanudar <archivo>      Continúa exactamente una ejecución desde su checkpoint" << endl;
+        cerr << "  --sembrar-desde <archivo> Arranca la población con los planes de un checkpoint" << endl;
+        cerr << "  --ventana <W>             Horizonte rodante: optimiza ventanas de W ticks" << endl;
+        cerr << "  --avance <S>              Ticks fijados por ventana (por defecto W/2)" << endl;
+        cerr << "  --islas <n>      Modelo de islas con n subpoblaciones, una por hilo (por defecto 1)" << endl;
+        cerr << "  --migracion <g>  Generaciones entre migraciones (por defecto 25)" << endl;
+        cerr << "  --migrantes <n>  Individuos enviados por migración (por defecto 2)" << endl;
+        cerr << "  --topologia <t>  Topología de migración: anillo o completa (por defecto anillo)" << endl;
+        cerr << "  --mutacion-islas <p1,p2,...>  Tasas de mutación asignadas a las islas en ciclo" << endl;
+        cerr << "     ./PSP-UAV --verificar <ruta_instancia>..." << endl;
+        cerr << "     ./PSP-UAV --barrido <configuracion> [--hilos <n>] [--salida <csv>]" << endl;
+        cerr << "     ./PSP-UAV --convertir <instancia.txt> <instancia.bin>" << endl;
         cerr << "Ejemplo: ./PSP-UAV instancias/PSP-UAV_01_a.txt 5 1000 50" << endl;
         return 1;
     }
@@ -663,40 +5781,474 @@ int main(int argc, char* argv[]) {
     int num_drones = stoi(argv[2]);
     int K_iteraciones = stoi(argv[3]);
     int T_ticks_operacion = stoi(argv[4]);
+    int num_hilos = 1;
+    int max_controles = 0;
+    int num_elite = 1;
+    bool semilla_fija = false;
+    uint32_t semilla = 0;
+    int pop_size = 150;
+    double mut_rate = 0.05;
+    int tam_torneo = 5;
+    int num_islas = 1;
+    int intervalo_migracion = 25;
+    int num_migrantes = 2;
+    TopologiaIslas topologia = TOPOLOGIA_ANILLO;
+    vector<double> mutaciones_islas;
+    CriterioParada criterio;
+    int intervalo_memetico = 0;
+    int top_memetico = 2;
+    int pasos_memetico = 20;
+    bool imprimir_rutas = true;
+    FormatoRutas formato_rutas = RUTAS_CSV;
+    size_t entradas_cache = 0;
+    string ruta_traza;
+    string ruta_checkpoint;
+    int cada_checkpoint = 100;
+    string ruta_reanudar;
+    string ruta_sembrar;
+    size_t capacidad_traza = 1024;
+    int ventana = 0;
+    int avance = 0;
+    vector<pair<OperadorMutacion, double>> operadores = {{mutacionPuntual, 1.0}};
+    bool fusionado = false;
+    bool multiobjetivo = false;
+
+    for (int i = 5; i < argc; ++i) {
+        string opcion = argv[i];
+        if (opcion == "--hilos" && i + 1 < argc) {
+            num_hilos = stoi(argv[++i]);
+            if (num_hilos == 0) num_hilos = thread::hardware_concurrency();
+        } else if (opcion == "--controles" && i + 1 < argc) {
+            max_controles = stoi(argv[++i]);
+        } else if (opcion == "--elite" && i + 1 < argc) {
+            num_elite = stoi(argv[++i]);
+        } else if (opcion == "--semilla" && i + 1 < argc) {
+            semilla = static_cast<uint32_t>(stoul(argv[++i]));
+            semilla_fija = true;
+        } else if (opcion == "--poblacion" && i + 1 < argc) {
+            pop_size = stoi(argv[++i]);
+        } else if (opcion == "--mutacion" && i + 1 < argc) {
+            mut_rate = stod(argv[++i]);
+        } else if (opcion == "--torneo" && i + 1 < argc) {
+            tam_torneo = stoi(argv[++i]);
+        } else if (opcion == "--tiempo-max" && i + 1 < argc) {
+            criterio.tiempo_max_s = stod(argv[++i]);
+        } else if (opcion == "--max-evaluaciones" && i + 1 < argc) {
+            criterio.max_evaluaciones = stol(argv[++i]);
+        } else if (opcion == "--estancamiento" && i + 1 < argc) {
+            criterio.estancamiento = stoi(argv[++i]);
+        } else if (opcion == "--epsilon" && i + 1 < argc) {
+            criterio.epsilon = stod(argv[++i]);
+        } else if (opcion == "--memetico" && i + 1 < argc) {
+            intervalo_memetico = stoi(argv[++i]);
+        } else if (opcion == "--memetico-top" && i + 1 < argc) {
+            top_memetico = stoi(argv[++i]);
+        } else if (opcion == "--memetico-pasos" && i + 1 < argc) {
+            pasos_memetico = stoi(argv[++i]);
+        } else if (opcion == "--sin-rutas") {
+            imprimir_rutas = false;
+        } else if (opcion == "--rutas" && i + 1 < argc) {
+            string nombre = argv[++i];
+            if (nombre == "csv") {
+                formato_rutas = RUTAS_CSV;
+            } else if (nombre == "binario") {
+                formato_rutas = RUTAS_BINARIO;
+            } else if (nombre == "ninguno") {
+                formato_rutas = RUTAS_NINGUNO;
+            } else {
+                cerr << "Error: Formato de rutas desconocido: " << nombre << endl;
+                return 1;
+            }
+        } else if (opcion == "--cache" && i + 1 < argc) {
+            entradas_cache = stoul(argv[++i]);
+        } else if (opcion == "--traza" && i + 1 < argc) {
+            ruta_traza = argv[++i];
+        } else if (opcion == "--traza-buffer" && i + 1 < argc) {
+            capacidad_traza = stoul(argv[++i]);
+        } else if (opcion == "--checkpoint" && i + 1 < argc) {
+            ruta_checkpoint = argv[++i];
+        } else if (opcion == "--checkpoint-cada" && i + 1 < argc) {
+            cada_checkpoint = stoi(argv[++i]);
+        } else if (opcion == "--reanudar" && i + 1 < argc) {
+            ruta_reanudar = argv[++i];
+        } else if (opcion == "--sembrar-desde" && i + 1 < argc) {
+            ruta_sembrar = argv[++i];
+        } else if (opcion == "--operadores" && i + 1 < argc) {
+            operadores.clear();
+            stringstream lista(argv[++i]);
+            string elemento;
+            while (getline(lista, elemento, ',')) {
+                size_t dos_puntos = elemento.find(':');
+                string nombre = elemento.substr(0, dos_puntos);
+                double peso = (dos_puntos == string::npos) ? 1.0 : stod(elemento.substr(dos_puntos + 1));
+                OperadorMutacion operador = operadorMutacionPorNombre(nombre);
+                if (!operador || !(peso >= 0.0)) {
+                    cerr << "Error: Operador de mutación inválido: " << elemento << endl;
+                    return 1;
+                }
+                operadores.push_back({operador, peso});
+            }
+            bool alguno = false;
+            for (const auto& op : operadores) alguno |= op.second > 0.0;
+            if (!alguno) {
+                cerr << "Error: --operadores requiere al menos un operador con peso positivo" << endl;
+                return 1;
+            }
+        } else if (opcion == "--fusionado") {
+            fusionado = true;
+        } else if (opcion == "--multiobjetivo") {
+            multiobjetivo = true;
+        } else if (opcion == "--ventana" && i + 1 < argc) {
+            ventana = stoi(argv[++i]);
+        } else if (opcion == "--avance" && i + 1 < argc) {
+            avance = stoi(argv[++i]);
+        } else if (opcion == "--islas" && i + 1 < argc) {
+            num_islas = max(1, stoi(argv[++i]));
+        } else if (opcion == "--migracion" && i + 1 < argc) {
+            intervalo_migracion = stoi(argv[++i]);
+        } else if (opcion == "--migrantes" && i + 1 < argc) {
+            num_migrantes = stoi(argv[++i]);
+        } else if (opcion == "--topologia" && i + 1 < argc) {
+            string nombre = argv[++i];
+            if (nombre == "anillo") {
+                topologia = TOPOLOGIA_ANILLO;
+            } else if (nombre == "completa") {
+                topologia = TOPOLOGIA_COMPLETA;
+            } else {
+                cerr << "Error: Topología desconocida: " << nombre << endl;
+                return 1;
+            }
+        } else if (opcion == "--mutacion-islas" && i + 1 < argc) {
+            stringstream lista(argv[++i]);
+            string valor;
+            while (getline(lista, valor, ',')) mutaciones_islas.push_back(stod(valor));
+        } else if (opcion == "--rng" && i + 1 < argc) {
+            string nombre = argv[++i];
+            if (nombre == "mt19937") {
+                tipo_rng_defecto = RNG_MT19937;
+            } else if (nombre == "xoshiro") {
+                tipo_rng_defecto = RNG_XOSHIRO;
+            } else {
+                cerr << "Error: Generador desconocido: " << nombre << endl;
+                return 1;
+            }
+        } else if (opcion == "--kernel" && i + 1 < argc) {
+            string nombre = argv[++i];
+            kernel_urgencia_defecto = kernelUrgenciaPorNombre(nombre);
+            if (!kernel_urgencia_defecto) {
+                cerr << "Error: Kernel no disponible en esta CPU: " << nombre << endl;
+                return 1;
+            }
+        } else if (opcion == "--evaluador" && i + 1 < argc) {
+            string nombre = argv[++i];
+            if (nombre != "denso" && nombre != "perezoso") {
+                cerr << "Error: Evaluador desconocido: " << nombre << " (denso o perezoso)" << endl;
+                return 1;
+            }
+            evaluacion_perezosa_defecto = (nombre == "perezoso");
+        } else {
+            cerr << "Error: Opción desconocida o incompleta: " << opcion << endl;
+            return 1;
+        }
+    }
+    ParametrosEjecucion parametros = {num_drones, T_ticks_operacion, K_iteraciones, pop_size, mut_rate,
+                                      tam_torneo, num_elite, criterio, intervalo_memetico, top_memetico,
+                                      pasos_memetico, entradas_cache};
+    if (!parametrosValidos(parametros, "")) {
+        return 1;
+    }
+    if (fusionado) {
+        for (const auto& op : operadores) {
+            if (op.second > 0.0 && op.first != mutacionPuntual && op.first != mutacionUrgencia) {
+                cerr << "Error: --fusionado solo admite los operadores puntual y urgencia" << endl;
+                return 1;
+            }
+        }
+    }
+    if (multiobjetivo && (num_islas > 1 || ventana > 0 || fusionado || intervalo_memetico > 0 ||
+                          entradas_cache > 0 || !ruta_traza.empty())) {
+        cerr << "Error: --multiobjetivo no se puede combinar con --islas, --ventana, --fusionado, "
+                "--memetico, --cache ni --traza" << endl;
+        return 1;
+    }
+    if (multiobjetivo && num_drones < 1) {
+        cerr << "Error: --multiobjetivo necesita al menos 1 dron (max_drones = " << num_drones << ")" << endl;
+        return 1;
+    }
+    if ((!ruta_checkpoint.empty() || !ruta_reanudar.empty() || !ruta_sembrar.empty()) &&
+        (num_islas > 1 || ventana > 0 || multiobjetivo)) {
+        cerr << "Error: --checkpoint, --reanudar y --sembrar-desde solo están disponibles con una población "
+                "(sin --islas, --ventana ni --multiobjetivo)" << endl;
+        return 1;
+    }
+    if (!ruta_reanudar.empty() && !ruta_sembrar.empty()) {
+        cerr << "Error: --reanudar y --sembrar-desde son excluyentes" << endl;
+        return 1;
+    }
+    if (cada_checkpoint < 1) {
+        cerr << "Error: --checkpoint-cada debe ser al menos 1" << endl;
+        return 1;
+    }
+    if (ventana > 0) {
+        if (avance <= 0) avance = max(1, ventana / 2);
+        if (ventana < 3 || avance > ventana) {
+            cerr << "Error: --ventana debe ser al menos 3 y --avance no puede superarla" << endl;
+            return 1;
+        }
+        if (num_islas > 1) {
+            cerr << "Error: --ventana no se puede combinar con --islas" << endl;
+            return 1;
+        }
+    }
 
     auto t_start = chrono::high_resolution_clock::now();
 
     // Cargar instancia del problema
     Instancia inst(ruta_instancia);
 
-    // Parámetros del algoritmo evolutivo (ajustados para mejor convergencia)
-    const int pop_size = 150;
-    const double mut_rate = 0.05;
+    // Al reanudar, la semilla y el generador son los de la ejecución original
+    unique_ptr<Checkpoint> checkpoint;
+    bool reanudar = !ruta_reanudar.empty();
+    if (reanudar || !ruta_sembrar.empty()) {
+        checkpoint.reset(new Checkpoint(leerCheckpoint(reanudar ? ruta_reanudar : ruta_sembrar)));
+    }
+    if (reanudar) {
+        if (checkpoint->cabecera.huella_instancia != inst.huella()) {
+            throw runtime_error("el checkpoint es de otra instancia; use --sembrar-desde para "
+                                "arrancar desde sus planes");
+        }
+        if (criterio.max_evaluaciones > 0 &&
+            (entradas_cache > 0 || checkpoint->cabecera.configuracion.entradas_cache > 0)) {
+            throw runtime_error("--reanudar con --max-evaluaciones no admite la caché de fitness (--cache): "
+                                "no se guarda en el checkpoint y al reconstruirla cambian las evaluaciones "
+                                "contadas y con ellas la generación del corte");
+        }
+        semilla = checkpoint->cabecera.semilla;
+        semilla_fija = true;
+        tipo_rng_defecto = static_cast<TipoRng>(checkpoint->cabecera.tipo_rng);
+    }
+
+    if (!semilla_fija) {
+        semilla = random_device{}();
+    }
 
     cout << "--- Iniciando Búsqueda Evolutiva (PSP-UAV) ---" << endl;
     cout << "Instancia: " << ruta_instancia << endl;
-    cout << "Número de drones: " << num_drones << endl;
+    cout << (multiobjetivo ? "Número máximo de drones: " : "Número de drones: ") << num_drones << endl;
     cout << "Iteraciones: " << K_iteraciones << endl;
     cout << "Ticks de operación (T): " << T_ticks_operacion << endl;
+    cout << "Hilos: " << num_hilos << endl;
+    cout << "Semilla: " << semilla << " (" << nombreRng(tipo_rng_defecto) << ")" << endl;
+    if (num_islas > 1) {
+        cout << "Islas: " << num_islas << " (migración cada " << intervalo_migracion << " generaciones, "
+             << num_migrantes << " migrantes, topología "
+             << (topologia == TOPOLOGIA_ANILLO ? "anillo" : "completa") << ")" << endl;
+    }
+    if (ventana > 0) {
+        cout << "Horizonte rodante: ventanas de " << ventana << " ticks, avance de " << avance << endl;
+    }
+    if (multiobjetivo) {
+        cout << "Multiobjetivo: urgencia acumulada vs. drones activos (NSGA-II)" << endl;
+    }
+    if (reanudar) {
+        cout << "Reanudando desde " << ruta_reanudar << " (generación " << checkpoint->cabecera.generacion
+             << ")" << endl;
+    } else if (checkpoint) {
+        cout << "Arranque en caliente desde " << ruta_sembrar << " (" << checkpoint->poblacion.size()
+             << " planes de k=" << checkpoint->cabecera.k << ", T=" << checkpoint->cabecera.T << ")" << endl;
+    }
     cout << "------------------------------------------------" << endl;
 
-    // Ejecutar algoritmo evolutivo con cantidad exacta de drones
-    AlgoritmoEvolutivo ae(pop_size, mut_rate, num_drones, T_ticks_operacion, inst);
-    ae.inicializarPoblacion();
+    if (multiobjetivo) {
+        // Un frente de Pareto (mejor plan por número de drones) en una sola ejecución
+        criterio.max_generaciones = K_iteraciones;
+        ControlParada parada(criterio);
+        AlgoritmoMultiobjetivo mo(pop_size, mut_rate, num_drones, T_ticks_operacion, inst, semilla, num_hilos);
+        mo.operadores.tam_torneo = tam_torneo;
+        mo.operadores.fijarOperadoresMutacion(operadores);
+        mo.inicializarPoblacion();
 
-    // Evolucionar durante K generaciones
-    for (int g = 0; g < K_iteraciones; ++g) {
-        ae.ejecutarGeneracion();
-        
-        // Mostrar progreso cada 10% de iteraciones
-        if ((g + 1) % (K_iteraciones / 10) == 0 || g == 0) {
-            Individuo mejor_actual = ae.getMejorIndividuo();
-            cout << "Iteración " << (g + 1) << "/" << K_iteraciones 
-                 << " - Mejor fitness: " << mejor_actual.fitness << endl;
+        const int paso_progreso = K_iteraciones >= 10 ? K_iteraciones / 10 : 100;
+        long evaluaciones_previas = 0;
+        while (parada.continuar(mo.indicadorFrente(), mo.evaluacionesTotales() - evaluaciones_previas)) {
+            evaluaciones_previas = mo.evaluacionesTotales();
+            mo.ejecutarGeneracion();
+            int g = parada.generaciones() - 1;
+            if ((g + 1) % paso_progreso == 0 || g == 0) {
+                cout << "Iteración " << (g + 1);
+                if (K_iteraciones > 0) cout << "/" << K_iteraciones;
+                cout << " - Frente de Pareto: " << mo.frentePareto().size() << " soluciones" << endl;
+            }
+        }
+
+        double tiempo_total_s = chrono::duration<double>(chrono::high_resolution_clock::now() - t_start).count();
+        vector<const Individuo*> frente = mo.frentePareto();
+        cout << "\n--- FIN DE LA EJECUCIÓN ---" << endl;
+        cout << fixed << setprecision(1);
+        cout << "Frente de Pareto (drones activos: urgencia acumulada):" << endl;
+        for (const Individuo* plan : frente) {
+            cout << "  " << plan->base_ids.size() << ": " << plan->fitness
+                 << (plan->es_valido ? "" : " (inválida)") << endl;
+        }
+        cout << "Tiempo de ejecución: " << tiempo_total_s << "s" << endl;
+        cout << "Generaciones: " << parada.generaciones()
+             << " (parada por " << NOMBRES_PARADA[parada.motivo()] << ")" << endl;
+        cout << "Evaluaciones: " << mo.evaluacionesTotales() << " ("
+             << setprecision(0) << mo.evaluacionesTotales() / tiempo_total_s << " eval/s)"
+             << setprecision(1) << endl;
+
+        string nombre_inst = extraerNombreInstancia(ruta_instancia);
+        guardarFrenteParetoCSV(nombre_inst, num_drones, K_iteraciones, T_ticks_operacion, frente,
+                               tiempo_total_s, semilla, tipo_rng_defecto, parada.generaciones(),
+                               parada.motivo());
+        // Las rutas guardan un plan por número de drones: el del frente reemplaza al anterior
+        for (const Individuo* plan : frente) {
+            Trayectorias trayectorias = simularTrayectorias(*plan, inst, T_ticks_operacion);
+            if (imprimir_rutas) imprimirMejorRuta(trayectorias);
+            if (formato_rutas == RUTAS_CSV) {
+                guardarRutasCSV(nombre_inst, trayectorias);
+            } else if (formato_rutas == RUTAS_BINARIO) {
+                guardarRutasBinario(nombre_inst, trayectorias);
+            }
         }
+        return 0;
+    }
+
+    Individuo mejor_solucion_global;
+    long evaluaciones = 0;
+    long consultas_cache = 0;
+    long aciertos_cache = 0;
+    int generaciones = 0;
+    MotivoParada motivo = PARADA_ITERACIONES;
+    criterio.max_generaciones = K_iteraciones;
+    ControlParada parada(criterio, num_islas);
+    unique_ptr<TrazaConvergencia> traza;
+    if (!ruta_traza.empty()) {
+        traza.reset(new TrazaConvergencia(ruta_traza, num_islas, capacidad_traza));
     }
 
-    Individuo mejor_solucion_global = ae.getMejorIndividuo();
+    if (num_islas > 1) {
+        // Modelo de islas: cada subpoblación evoluciona en su propio hilo
+        if (mutaciones_islas.empty()) mutaciones_islas.push_back(mut_rate);
+        ModeloIslas modelo(num_islas, pop_size, mutaciones_islas, tam_torneo, num_drones,
+                           T_ticks_operacion, inst, semilla, max_controles, num_elite,
+                           intervalo_migracion, num_migrantes, topologia);
+        if (intervalo_memetico > 0) {
+            for (auto& isla : modelo.islas) {
+                isla->activarBusquedaLocal(intervalo_memetico, top_memetico, pasos_memetico);
+            }
+        }
+        for (int i = 0; i < num_islas; ++i) {
+            modelo.islas[i]->activarCache(entradas_cache);
+            modelo.islas[i]->fijarOperadoresMutacion(operadores);
+            modelo.islas[i]->fusionado = fusionado;
+            if (traza) modelo.islas[i]->activarTraza(traza.get(), i);
+        }
+        modelo.ejecutar(parada);
+
+        for (int i = 0; i < num_islas; ++i) {
+            const AlgoritmoEvolutivo& isla = *modelo.islas[i];
+            cout << "Isla " << i << " (mutación " << isla.tasa_mutacion << ") - Mejor fitness: "
+                 << fixed << setprecision(1) << isla.getMejorIndividuo().fitness << defaultfloat << " - Inmigrantes aceptados: "
+                 << modelo.inmigrantes_aceptados[i] << endl;
+        }
+        mejor_solucion_global = modelo.getMejorIndividuo();
+        evaluaciones = modelo.evaluacionesTotales();
+        for (const auto& isla : modelo.islas) {
+            consultas_cache += isla->consultas_cache;
+            aciertos_cache += isla->aciertos_cache;
+        }
+        generaciones = parada.generaciones();
+        motivo = parada.motivo();
+    } else if (ventana > 0) {
+        // Horizonte rodante: un AE nuevo (configurado como el de una sola población) por ventana
+        auto crear_ae = [&](int ticks, uint32_t semilla_ventana) {
+            unique_ptr<AlgoritmoEvolutivo> ae(new AlgoritmoEvolutivo(
+                pop_size, mut_rate, num_drones, ticks, inst, semilla_ventana, num_hilos,
+                max_controles, num_elite));
+            ae->tam_torneo = tam_torneo;
+            if (intervalo_memetico > 0) {
+                ae->activarBusquedaLocal(intervalo_memetico, top_memetico, pasos_memetico);
+            }
+            ae->activarCache(entradas_cache);
+            ae->fijarOperadoresMutacion(operadores);
+            ae->fusionado = fusionado;
+            if (traza) ae->activarTraza(traza.get(), 0);
+            return ae;
+        };
+        ResultadoHorizonteRodante res = ejecutarHorizonteRodante(
+            inst, num_drones, T_ticks_operacion, ventana, avance, criterio, semilla, crear_ae);
+        mejor_solucion_global = move(res.plan);
+        evaluaciones = res.evaluaciones;
+        consultas_cache = res.consultas_cache;
+        aciertos_cache = res.aciertos_cache;
+        generaciones = res.generaciones;
+        motivo = res.motivo;
+    } else {
+        // Ejecutar algoritmo evolutivo con cantidad exacta de drones
+        AlgoritmoEvolutivo ae(pop_size, mut_rate, num_drones, T_ticks_operacion, inst,
+                              semilla, num_hilos, max_controles, num_elite);
+        ae.tam_torneo = tam_torneo;
+        if (intervalo_memetico > 0) {
+            ae.activarBusquedaLocal(intervalo_memetico, top_memetico, pasos_memetico);
+        }
+        ae.activarCache(entradas_cache);
+        ae.fijarOperadoresMutacion(operadores);
+        ae.fusionado = fusionado;
+        if (traza) ae.activarTraza(traza.get(), 0);
+        long evaluaciones_previas = 0;
+        if (reanudar) {
+            ae.restaurarEstado(*checkpoint);
+            parada.restaurar(checkpoint->cabecera.parada);
+            evaluaciones_previas = checkpoint->cabecera.parada.evaluaciones;
+        } else {
+            ae.inicializarPoblacion(checkpoint ? &checkpoint->poblacion : nullptr);
+        }
+        checkpoint.reset();
+        unique_ptr<EscritorCheckpoint> escritor;
+        vector<char> buffer_checkpoint;
+        if (!ruta_checkpoint.empty()) {
+            escritor.reset(new EscritorCheckpoint(ruta_checkpoint));
+        }
+
+        // Evolucionar hasta cumplir un criterio de parada
+        const int paso_progreso = K_iteraciones >= 10 ? K_iteraciones / 10 : 100;
+        while (parada.continuar(ae.getMejorIndividuo().fitness,
+                                ae.evaluacionesTotales() - evaluaciones_previas)) {
+            evaluaciones_previas = ae.evaluacionesTotales();
+            ae.ejecutarGeneracion();
+            int g = parada.generaciones() - 1;
+            if (escritor && (g + 1) % cada_checkpoint == 0) {
+                ae.serializarEstado(buffer_checkpoint, semilla, parada.estado());
+                escritor->encolar(buffer_checkpoint);
+            }
+            
+            // Mostrar progreso cada 10% de iteraciones
+            if ((g + 1) % paso_progreso == 0 || g == 0) {
+                const Individuo& mejor_actual = ae.getMejorIndividuo();
+                cout << "Iteración " << (g + 1);
+                if (K_iteraciones > 0) cout << "/" << K_iteraciones;
+                cout << " - Mejor fitness: " << mejor_actual.fitness << endl;
+            }
+        }
+
+        if (escritor) {
+            // Checkpoint final: permite continuar con un límite mayor
+            ae.serializarEstado(buffer_checkpoint, semilla, parada.estado());
+            escritor->encolar(buffer_checkpoint);
+            pair<long, long> escritos = escritor->esperar();
+            cout << "Checkpoint: " << ruta_checkpoint << " (" << escritos.first << " escritos";
+            if (escritos.second > 0) cout << ", " << escritos.second << " fallidos";
+            cout << ")" << endl;
+        }
+
+        mejor_solucion_global = ae.getMejorIndividuo();
+        evaluaciones = ae.evaluacionesTotales();
+        consultas_cache = ae.consultas_cache;
+        aciertos_cache = ae.aciertos_cache;
+        generaciones = parada.generaciones();
+        motivo = parada.motivo();
+    }
 
     auto t_end = chrono::high_resolution_clock::now();
     double tiempo_total_s = chrono::duration<double>(t_end - t_start).count();
@@ -710,15 +6262,54 @@ int main(int argc, char* argv[]) {
     cout << "Drones utilizados: " << num_drones << endl;
     cout << "Solución válida: " << (mejor_solucion_global.es_valido ? "Sí" : "No") << endl;
     cout << "Tiempo de ejecución: " << tiempo_total_s << "s" << endl;
+    cout << "Generaciones: " << generaciones
+         << " (parada por " << NOMBRES_PARADA[motivo] << ")" << endl;
+    cout << "Evaluaciones: " << evaluaciones << " ("
+         << setprecision(0) << evaluaciones / tiempo_total_s << " eval/s)"
+         << setprecision(1) << endl;
+    double tasa_cache = -1.0;
+    if (entradas_cache > 0) {
+        tasa_cache = consultas_cache > 0 ? static_cast<double>(aciertos_cache) / consultas_cache : 0.0;
+        cout << "Caché de fitness: " << aciertos_cache << " aciertos de " << consultas_cache
+             << " hijos (" << 100.0 * tasa_cache << "%)" << endl;
+    }
+    if (traza) {
+        long generaciones_traza = traza->cerrar();
+        cout << "Traza de convergencia: " << ruta_traza << " (" << generaciones_traza
+             << " generaciones)" << endl;
+    }
     
-    imprimirMejorRuta(mejor_solucion_global, inst, T_ticks_operacion);
+    // Una sola simulación de la mejor solución para la consola y los archivos de rutas
+    Trayectorias trayectorias = simularTrayectorias(mejor_solucion_global, inst, T_ticks_operacion);
+    if (imprimir_rutas) {
+        imprimirMejorRuta(trayectorias);
+    }
     
     // Guardar resultados en archivos CSV
     string nombre_inst = extraerNombreInstancia(ruta_instancia);
     guardarResultadosCSV(nombre_inst, num_drones, K_iteraciones, T_ticks_operacion, 
-                         mejor_solucion_global, tiempo_total_s);
-    guardarRutasCSV(nombre_inst, num_drones, K_iteraciones, T_ticks_operacion,
-                    mejor_solucion_global, inst, T_ticks_operacion);
+                         mejor_solucion_global, tiempo_total_s, semilla, tipo_rng_defecto,
+                         generaciones, motivo, tasa_cache);
+    if (formato_rutas == RUTAS_CSV) {
+        guardarRutasCSV(nombre_inst, trayectorias);
+    } else if (formato_rutas == RUTAS_BINARIO) {
+        guardarRutasBinario(nombre_inst, trayectorias);
+    }
 
     return 0;
-}
\ No newline at end of file
+}
+
+/*
+ * main
+ * Ejecuta el programa e informa como error cualquier excepción (por ejemplo,
+ * una instancia que no existe o no es válida).
+ */
+int main(int argc, char* argv[]) {
+    try {
+        return ejecutarPrograma(argc, argv);
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+}
+#endif
\ No newline at end of file
@@ -6,15 +6,74 @@ desde un solo archivo CSV acumulativo
 """
 
 import csv
+import struct
 import matplotlib.pyplot as plt
 import numpy as np
 from pathlib import Path
 
+# Desplazamiento (fila, columna) de cada acción 0-8 (mismo orden que main.cpp)
+DELTA_FILA = [0, -1, -1, 0, 1, 1, 1, 0, -1]
+DELTA_COL = [0, 0, 1, 1, 1, 0, -1, -1, -1]
+
+def cargar_rutas_binario(archivo, num_drones_filtro=None):
+    """
+    Carga rutas desde el archivo binario de ./PSP-UAV --rutas binario
+    Cada registro trae k, T y, por dron, base y posición inicial seguidas de
+    T acciones; las posiciones se reconstruyen sumando los desplazamientos.
+    """
+    rutas = {}
+    
+    with open(archivo, 'rb') as f:
+        datos = f.read()
+    
+    if datos[:8] != b'PSPRUTA\0':
+        raise ValueError(f"{archivo} no es un archivo binario de rutas")
+    (version,) = struct.unpack_from('<I', datos, 8)
+    if version != 1:
+        raise ValueError(f"{archivo}: versión {version} no soportada")
+    
+    pos = 12
+    while pos < len(datos):
+        k, T = struct.unpack_from('<ii', datos, pos)
+        pos += 8
+        for dron in range(k):
+            base, fila, col = struct.unpack_from('<iii', datos, pos)
+            pos += 12
+            acciones = datos[pos:pos + T]
+            pos += T
+            
+            if num_drones_filtro is not None and k != num_drones_filtro:
+                continue
+            
+            trayectoria = [{'tick': 0, 'fila': fila, 'col': col, 'accion': 0, 'base': base}]
+            for t, accion in enumerate(acciones):
+                fila += DELTA_FILA[accion]
+                col += DELTA_COL[accion]
+                trayectoria.append({'tick': t + 1, 'fila': fila, 'col': col,
+                                    'accion': accion, 'base': base})
+            rutas.setdefault(k, {})[dron] = trayectoria
+    
+    return rutas
+
+def archivo_rutas_de(archivo_instancia):
+    """
+    Ruta del archivo de rutas de la instancia: si existen el CSV y el binario
+    se usa el modificado más recientemente (el de la última ejecución)
+    """
+    existentes = [Path(f"resultados/{archivo_instancia}_rutas.{ext}") for ext in ('csv', 'bin')]
+    existentes = [ruta for ruta in existentes if ruta.exists()]
+    if not existentes:
+        return f"resultados/{archivo_instancia}_rutas.csv"
+    return str(max(existentes, key=lambda ruta: ruta.stat().st_mtime))
+
 def cargar_rutas(archivo, num_drones_filtro=None):
     """
-    Carga rutas desde archivo CSV
+    Carga rutas desde archivo CSV o binario (.bin)
     Si num_drones_filtro es None, carga todas las configuraciones
     """
+    if str(archivo).endswith('.bin'):
+        return cargar_rutas_binario(archivo, num_drones_filtro)
+    
     rutas = {}
     
     with open(archivo, 'r') as f:
@@ -45,7 +104,7 @@ def cargar_rutas(archivo, num_drones_filtro=None):
 
 def visualizar_rutas(archivo_instancia, num_drones, titulo=None):
     """Visualiza las rutas de una configuración específica"""
-    archivo_rutas = f"resultados/{archivo_instancia}_rutas.csv"
+    archivo_rutas = archivo_rutas_de(archivo_instancia)
     
     if not Path(archivo_rutas).exists():
         print(f"❌ Archivo no encontrado: {archivo_rutas}")
@@ -95,7 +154,7 @@ def visualizar_rutas(archivo_instancia, num_drones, titulo=None):
 
 def comparar_configuraciones(archivo_instancia):
     """Genera subplots comparando diferentes configuraciones de drones"""
-    archivo_rutas = f"resultados/{archivo_instancia}_rutas.csv"
+    archivo_rutas = archivo_rutas_de(archivo_instancia)
     
     if not Path(archivo_rutas).exists():
         print(f"❌ Archivo no encontrado: {archivo_rutas}")